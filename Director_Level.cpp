@@ -11,6 +11,7 @@
 #include "Purpose/Assets/EventAsset.h"
 #include "Purpose/DataChunks/TrackedPurposes.h"
 #include "EngineUtils.h"
+#include "Async/Async.h"
 #include "AIActivity.h"
 #include "Purpose/DataChunks/ActorRole.h"
 #include "Purpose/DataChunks/ActorLocation.h"
@@ -20,7 +21,8 @@
 ADirector_Level::ADirector_Level()
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = false;
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;/// Publish the blackboard after the world has finished updating for the frame
 	bReplicates = false;
 }
 
@@ -29,26 +31,67 @@ void ADirector_Level::BeginPlay()
 {
 	Super::BeginPlay();
 	Global::Log(CALLTRACEESSENTIAL, MANAGEMENT, *this, "BeginPlay", TEXT(""));
+
+	dataChunkPool.Initialize(this);
+
+	worldStateBlackboard.RegisterEntity(this);/// The director is the candidate of Event selection, so it needs to be readable like any other subject
+
 	AddData(NewObject<UTrackedPurposes>(this));
+	trackedPurposes.BindView(DataChunk<UTrackedPurposes>());
 
 	Init();
 
-	UAssetManager* assetManager = GEngine->AssetManager;
-	if (!assetManager)
+	LoadEventAssetsInBatches();
+}
+
+
+void ADirector_Level::AddData(UDataChunk* inData, bool overwriteValue)
+{
+	UDataChunk* replaced = IsValid(inData) && HasData(inData->GetClass()) ? DataChunk(inData->GetClass()) : nullptr;
+	IDataMapInterface::AddData(inData, overwriteValue);
+	IncrementDataMapVersion();
+	ReleaseDataChunk(replaced);/// Does nothing unless the chunk was actually replaced
+}
+
+void ADirector_Level::AppendData(const TArray<FDataMapEntry>& inDataMap, bool overwriteValue)
+{
+	TArray<UDataChunk*> replaced;
+	for (const FDataMapEntry& entry : inDataMap)
 	{
-		Global::LogError(MANAGEMENT, * this, "BeginPlay", TEXT("Asset manager invalid!"));
-		return;
+		if (IsValid(entry.Chunk) && HasData(entry.Chunk->GetClass()))
+		{
+			replaced.Add(DataChunk(entry.Chunk->GetClass()));
+		}
 	}
 
-	TSharedPtr<FStreamableHandle> callback = assetManager->LoadPrimaryAssetsWithType(UEventAsset::PrimaryAssetType(), TArray<FName>(), FStreamableDelegate::CreateUObject(this, &ADirector_Level::EventAssetsLoaded));
+	IDataMapInterface::AppendData(inDataMap, overwriteValue);
+	IncrementDataMapVersion();
 
-	if (!callback)
+	for (UDataChunk* chunk : replaced)
 	{
-		Global::LogError(PURPOSE, *this, "BeginPlay", TEXT("Callback to load EventAssets invalid!."));
-		return;
+		ReleaseDataChunk(chunk);
 	}
 }
 
+void ADirector_Level::RemoveData(TSubclassOf<UDataChunk> inClass)
+{
+	UDataChunk* removed = HasData(inClass) ? DataChunk(inClass) : nullptr;
+	IDataMapInterface::RemoveData(inClass);
+	IncrementDataMapVersion();
+	ReleaseDataChunk(removed);
+}
+
+void ADirector_Level::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	worldStateBlackboard.Publish();
+
+	if (eventRegistry.HasPendingUnloads())
+	{
+		UnloadUnreferencedEvents();
+	}
+}
 
 #pragma region Event System
 
@@ -134,15 +177,19 @@ bool ADirector_Level::ProvidePurposeToOwner(const FContextData& purposeToStore)
 	switch (purposeToStore.addressOfPurpose.GetAddressLayer())
 	{
 		case (int)EPurposeLayer::Event:
-			if (!HasData(UTrackedPurposes::StaticClass()))
+			if (!eventRegistry.IsCurrent(purposeToStore.addressOfPurpose))
 			{
-				Global::LogError(EVENT, *this, "ProvidePurposeToOwner", TEXT("Director does not have tracked purposes!"));
+				Global::LogError(EVENT, *this, "ProvidePurposeToOwner", TEXT("Purpose: %s was selected from an Event since unloaded, address %s is stale!")
+					, *purposeToStore.GetName()
+					, *purposeToStore.addressOfPurpose.GetAddressAsString()
+				);
 				return false;
 			}
 
-			if (!DataChunk<UTrackedPurposes>()->Value().Contains(purposeToStore))
+			if (FContextData* trackedEvent = trackedPurposes.Add(purposeToStore))///Ensure that selected context is stored until it ends
 			{
-				DataChunk<UTrackedPurposes>()->AddToValue(purposeToStore);///Ensure that selected context is stored until it ends
+				contextTrees.Register(*trackedEvent);
+
 				Global::Log(DATADEBUG, EVENT, *this, "ProvidePurposeToOwner", TEXT("Adding Purpose: %s; Description: %s")
 					, *purposeToStore.GetName()
 					, *purposeToStore.Description()
@@ -168,81 +215,101 @@ bool ADirector_Level::ProvidePurposeToOwner(const FContextData& purposeToStore)
 	return false;
 }
 
-TArray<FPurpose> ADirector_Level::GetEventAssets()
+void ADirector_Level::CompilePurposeTree()
 {
-	TArray<FPurpose> purposes;
-	for (FEventLayer& storedEvent : eventCacheForPurposeSystem)
-	{
-		purposes.Add(storedEvent);
-	}
+	check(IsInGameThread());
+
+	appliedPurposeTreeGeneration = ++purposeTreeGeneration;
+	purposeTree = FCompiledPurposeTree::Compile(eventRegistry.Events(), eventRegistry.Resident(), eventRegistry.Generations());
 
-	return purposes;
+	Global::Log(DATADEBUG, PURPOSE, *this, "CompilePurposeTree", TEXT("Compiled %d of %d Events into %d purposes.")
+		, purposeTree->NumResidentEvents()
+		, purposeTree->NumEvents()
+		, purposeTree->NumNodes()
+	);
 }
 
-TArray<FPurpose> ADirector_Level::GetSubPurposesFor(FPurposeAddress address)
+void ADirector_Level::CompilePurposeTreeAsync()
 {
-	TArray<FPurpose> subPurposes;
-
-	int purposeLayer = address.GetAddressLayer();
+	check(IsInGameThread());
 
-	int eventAddress = address.GetAddressForLayer((int)EPurposeLayer::Event);
-
-	if (!eventCacheForPurposeSystem.IsValidIndex(eventAddress))
+	const uint32 generation = ++purposeTreeGeneration;
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [weakDirector = TWeakObjectPtr<ADirector_Level>(this), generation, events = eventRegistry.Events(), resident = eventRegistry.Resident(), generations = eventRegistry.Generations()]() mutable
 	{
-		Global::LogError(EVENT, GetName(), "GetSubPurposesFor", TEXT("Address %s not found for Event"), *address.GetAddressAsString());
-		return TArray<FPurpose>();
-	}
-	
-	TArray<FGoalLayer>& goals = eventCacheForPurposeSystem[eventAddress].goals;
+		FCompiledPurposeTreePtr compiledTree = FCompiledPurposeTree::Compile(MoveTemp(events), MoveTemp(resident), generations);
 
-	if (purposeLayer == (int)EPurposeLayer::Event)
-	{
-		for (FPurpose& goal : goals)
+		AsyncTask(ENamedThreads::GameThread, [weakDirector, generation, compiledTree]()
 		{
-			subPurposes.Add(goal);
-		}
-		return subPurposes;
-	}
+			if (ADirector_Level* director = weakDirector.Get())
+			{
+				director->PurposeTreeCompiled(generation, compiledTree);
+			}
+		});
+	});
+}
 
-	int goalAddress = address.GetAddressForLayer((int)EPurposeLayer::Goal);
+void ADirector_Level::PurposeTreeCompiled(const uint32 generation, FCompiledPurposeTreePtr compiledTree)
+{
+	check(IsInGameThread());
 
-	if (!goals.IsValidIndex(goalAddress))
+	if (generation <= appliedPurposeTreeGeneration)
 	{
-		Global::LogError(EVENT, GetName(), "GetSubPurposesFor", TEXT("Address %s not found for Event"), *address.GetAddressAsString());
-		return TArray<FPurpose>();
+		return;
 	}
+	appliedPurposeTreeGeneration = generation;
+	purposeTree = compiledTree;
 
-	TArray<FObjectiveLayer>& objectives = goals[goalAddress].objectives;
+	Global::Log(DATADEBUG, PURPOSE, *this, "PurposeTreeCompiled", TEXT("Compiled %d of %d Events into %d purposes.")
+		, purposeTree->NumResidentEvents()
+		, purposeTree->NumEvents()
+		, purposeTree->NumNodes()
+	);
+}
 
-	if (purposeLayer == (int)EPurposeLayer::Goal)
+void ADirector_Level::UnloadUnreferencedEvents()
+{
+	auto IsReferenced = [this](const FPurposeAddress& eventAddress)
 	{
-		for (FPurpose& objective : objectives)
+		if (trackedPurposes.AnyBelongToEvent(eventAddress) || contextStore.AnyBelongToEvent(eventAddress))/// The store holds the Objective of every purpose component
 		{
-			subPurposes.Add(objective);
+			return true;
 		}
-		return subPurposes;
-	}
-
-	int objectiveAddress = address.GetAddressForLayer((int)EPurposeLayer::Objective);
+		for (TObjectPtr<AManager> manager : managers)
+		{
+			if (IsValid(manager) && manager->TrackedPurposes().AnyBelongToEvent(eventAddress))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
 
-	if (!objectives.IsValidIndex(objectiveAddress))
+	if (eventRegistry.UnloadReleased(IsReferenced) > 0)
 	{
-		Global::LogError(EVENT, GetName(), "GetSubPurposesFor", TEXT("Address %s not found for Event"), *address.GetAddressAsString());
-		return TArray<FPurpose>();
+		CompilePurposeTreeAsync();
 	}
+}
 
-	TArray<FTaskLayer>& tasks = objectives[goalAddress].tasks;
+void ADirector_Level::ActivityDestroyed(AActor* activity)
+{
+	const FPurposeAddress eventAddress = eventRegistry.Find(FSoftObjectPath(activity));
 
-	if (purposeLayer == (int)EPurposeLayer::Objective)
+	/// The activity's own Event context would otherwise keep its Event referenced for the rest of the session
+	int64 contextID = 0;
+	if (activityContextIDs.RemoveAndCopyValue(activity, contextID) && trackedPurposes.Find(contextID, eventAddress))
 	{
-		for (FPurpose& task : tasks)
+		for (TScriptInterface<IPurposeManagementInterface> participant : contextTrees.ParticipantsOf(contextID))
 		{
-			subPurposes.Add(task);
+			if (AManager* manager = Cast<AManager>(participant.GetObject()))
+			{
+				manager->EndGoalsOfEvent(contextID, eventAddress);
+			}
 		}
-		return subPurposes;
+		contextTrees.Unregister(contextID);
+		trackedPurposes.Remove(contextID, eventAddress);
 	}
 
-	return TArray<FPurpose>();
+	eventRegistry.Release(eventAddress);
 }
 
 void ADirector_Level::PurposeReOccurrence(const FPurposeAddress addressOfPurpose, const int64 uniqueIDofActivePurpose)
@@ -251,8 +318,9 @@ void ADirector_Level::PurposeReOccurrence(const FPurposeAddress addressOfPurpose
 	{
 		case (int)EPurposeLayer::Event: /// If an Event reoccurs, we want to notify the manager that the goals may be reevaluated as desired
 
-			for (TObjectPtr<AManager> manager : managers)
+			for (TScriptInterface<IPurposeManagementInterface> participant : contextTrees.ParticipantsOf(uniqueIDofActivePurpose))/// Only the managers holding Goals of this Event
 			{
+				AManager* manager = Cast<AManager>(participant.GetObject());
 				if (!IsValid(manager))
 				{
 					Global::LogError(MANAGEMENT, *this, "ReOccurrenceOfEventObjectives", TEXT("A manager is invalid!"));
@@ -265,32 +333,24 @@ void ADirector_Level::PurposeReOccurrence(const FPurposeAddress addressOfPurpose
 	}
 }
 
-FContextData& ADirector_Level::GetStoredPurpose(const int64 uniqueIdentifierOfContextTree, const FPurposeAddress& fullAddress, const int layerToRetrieveFor)
+FContextData* ADirector_Level::GetStoredPurpose(const int64 uniqueIdentifierOfContextTree, const FPurposeAddress& fullAddress, const int layerToRetrieveFor)
 {
 	switch (layerToRetrieveFor)
 	{
 		case (int)EPurposeLayer::Event:
 
-			for(FContextData& context : DataChunk<UTrackedPurposes>()->ValueNonConst())
-			{
-				if (context.GetContextID() == uniqueIdentifierOfContextTree && context.addressOfPurpose.GetAddressForLayer(layerToRetrieveFor) == fullAddress.GetAddressForLayer(layerToRetrieveFor))
-				{
-					return context;
-				}
-			}
-			break;
+			return trackedPurposes.FindForLayer(uniqueIdentifierOfContextTree, fullAddress, layerToRetrieveFor);
 	}
-	return FContextData();
+	return nullptr;
 }
 
 TArray<TObjectPtr<UBehavior_AI>> ADirector_Level::GetBehaviorsFromParent(const FPurposeAddress& parentAddress)
 {
 	TArray<TObjectPtr<UBehavior_AI>> behaviors;
-	TArray<FTaskLayer> tasks = GetTasksOfObjective(parentAddress);
 
-	for (FTaskLayer& task : tasks)
+	for (const FPurposeTreeNode& task : GetTasksOfObjective(parentAddress))
 	{
-		behaviors.Add(task.behaviorAbility);
+		behaviors.Add(task.behaviorAbility.Get());
 	}
 
 	return behaviors;
@@ -298,49 +358,38 @@ TArray<TObjectPtr<UBehavior_AI>> ADirector_Level::GetBehaviorsFromParent(const F
 
 TObjectPtr<UBehavior_AI> ADirector_Level::GetBehaviorAtAddress(const FPurposeAddress& inAddress)
 {
-	int eventAddress = inAddress.GetAddressForLayer((int)EPurposeLayer::Event);
-
-	if (!eventCacheForPurposeSystem.IsValidIndex(eventAddress))
-	{
-		Global::LogError(EVENT, GetName(), "GetSubPurposesFor", TEXT("Address %s not found for Event"), *inAddress.GetAddressAsString());
-		return nullptr;
-	}
-
-	TArray<FGoalLayer>& goals = eventCacheForPurposeSystem[eventAddress].goals;
+	const FPurposeTreeNode* task = purposeTree.IsValid() ? purposeTree->FindNode(inAddress) : nullptr;
 
-	int goalAddress = inAddress.GetAddressForLayer((int)EPurposeLayer::Goal);
-
-	if (!goals.IsValidIndex(goalAddress))
+	if (!task)
 	{
-		Global::LogError(EVENT, GetName(), "GetSubPurposesFor", TEXT("Address %s not found for Event"), *inAddress.GetAddressAsString());
+		Global::LogError(EVENT, GetName(), "GetBehaviorAtAddress", TEXT("Address %s not found for Event"), *inAddress.GetAddressAsString());
 		return nullptr;
 	}
 
-	TArray<FObjectiveLayer>& objectives = goals[goalAddress].objectives;
-
-	int objectiveAddress = inAddress.GetAddressForLayer((int)EPurposeLayer::Objective);
+	return task->behaviorAbility.Get();
+}
 
-	if (!objectives.IsValidIndex(objectiveAddress))
+/// Actions from ActionPerformed are stored inline, while contexts from abilities may still carry a UActorAction chunk
+/// @return const UClass*: The action of the context regardless of how it was stored, nullptr if there is none
+static const UClass* ActorActionOfContext(const TArray<FDataMapEntry>& context, const FInlineDataMap& contextValues)
+{
+	if (const FDataValue* inlineAction = contextValues.Find(UActorAction::StaticClass()))
 	{
-		Global::LogError(EVENT, GetName(), "GetSubPurposesFor", TEXT("Address %s not found for Event"), *inAddress.GetAddressAsString());
-		return nullptr;
+		return inlineAction->classValue;
 	}
 
-	TArray<FTaskLayer>& tasks = objectives[goalAddress].tasks;
-
-	int taskAddress = inAddress.GetAddressForLayer((int)EPurposeLayer::Behavior);
-
-	if (!tasks.IsValidIndex(taskAddress))
+	if (DataMapGlobals::HasData(context, UActorAction::StaticClass()))
 	{
-		Global::LogError(EVENT, GetName(), "GetSubPurposesFor", TEXT("Address %s not found for Event"), *inAddress.GetAddressAsString());
-		return nullptr;
+		return DataMapGlobals::DataChunk<UActorAction>(context)->Value();
 	}
-
-	return tasks[taskAddress].behaviorAbility;
+	return nullptr;
 }
 
-bool ADirector_Level::DoesPurposeAlreadyExist(const FContextData& primary, const FSubjectMap& secondarySubjects, const TArray<FDataMapEntry>& secondaryContext, const FPurposeAddress optionalAddress)
+bool ADirector_Level::DoesPurposeAlreadyExist(const FContextData& primary, const FSubjectMap& secondarySubjects, const TArray<FDataMapEntry>& secondaryContext, const FInlineDataMap& secondaryValues, const FPurposeAddress optionalAddress)
 {
+	const UClass* primaryAction = ActorActionOfContext(primary.contextData, primary.contextValues);
+	const UClass* secondaryAction = ActorActionOfContext(secondaryContext, secondaryValues);
+
 	//If the Instigator + action + target is already contained, ignore objective
 	if///If the action + target is already contained, ignore purpose
 		/// Design: AI Purpose Occurrence; New similarity comparison ignores instigator to avoid duplicate occurrences causing AI to swap objectives unnecsessarily
@@ -348,8 +397,8 @@ bool ADirector_Level::DoesPurposeAlreadyExist(const FContextData& primary, const
 		(
 			/*primary.Subject(ESubject::Instigator) == secondary.Subject(ESubject::Instigator)
 			&&*/ primary.Subject(ESubject::EventTarget) == (secondarySubjects.subjects.Contains(ESubject::EventTarget) ? secondarySubjects.subjects[ESubject::EventTarget].GetObject() : nullptr)
-			&& DataMapGlobals::HasData(primary.contextData, UActorAction::StaticClass()) && DataMapGlobals::HasData(secondaryContext, UActorAction::StaticClass())
-			&& DataMapGlobals::DataChunk<UActorAction>(primary.contextData)->Value() == DataMapGlobals::DataChunk<UActorAction>(secondaryContext)->Value()
+			&& primaryAction && secondaryAction
+			&& primaryAction == secondaryAction
 			)
 	{
 		return true;
@@ -359,8 +408,8 @@ bool ADirector_Level::DoesPurposeAlreadyExist(const FContextData& primary, const
 		(
 			primary.Subject(ESubject::Instigator) == (secondarySubjects.subjects.Contains(ESubject::EventTarget) ? secondarySubjects.subjects[ESubject::EventTarget].GetObject() : nullptr)
 			&& primary.Subject(ESubject::EventTarget) == (secondarySubjects.subjects.Contains(ESubject::Instigator) ? secondarySubjects.subjects[ESubject::Instigator].GetObject() : nullptr)
-			&& DataMapGlobals::HasData(primary.contextData, UActorAction::StaticClass()) && DataMapGlobals::HasData(secondaryContext, UActorAction::StaticClass())
-			&& DataMapGlobals::DataChunk<UActorAction>(primary.contextData)->Value() == DataMapGlobals::DataChunk<UActorAction>(secondaryContext)->Value()
+			&& primaryAction && secondaryAction
+			&& primaryAction == secondaryAction
 			)
 	{
 		return true;
@@ -384,142 +433,153 @@ void ADirector_Level::AllSubPurposesComplete(const int64& uniqueContextID, const
 	switch (addressOfPurpose.GetAddressLayer())
 	{
 		case (int)EPurposeLayer::Event:
-
-			int indexOfStoredEvent = eventsActive.IsValidIndex(addressOfPurpose.GetAddressForLayer((int)EPurposeLayer::Event)) ? addressOfPurpose.GetAddressForLayer((int)EPurposeLayer::Event) : INDEX_NONE;
-			//int indexOfStoredEvent = eventsActive.IndexOfByKey(addressOfGoal);
-
-			if (indexOfStoredEvent == INDEX_NONE)
+		{
+			const FPurposeAddress eventAddress = addressOfPurpose.Truncate(1);
+			const FContextData* activeEvent = trackedPurposes.Find(uniqueContextID, eventAddress);
+			if (!activeEvent)
 			{
-				Global::LogError(GOAL, GetName(), "GoalComplete", TEXT("Address %s not found in eventsActive!"), *addressOfPurpose.GetAddressAsString());
+				Global::LogError(GOAL, GetName(), "GoalComplete", TEXT("Address %s not found in tracked purposes!"), *addressOfPurpose.GetAddressAsString());
 				return;
 			}
 
-			if (HasData(UTrackedPurposes::StaticClass()))
-			{
-				const FContextData& activeEvent = eventsActive[indexOfStoredEvent];
-				activeEvent.AdjustDataIfPossible(activeEvent.purpose.DataAdjustments(), EPurposeSelectionEvent::OnFinished, EVENT, "GoalComplete", this);
-				//Global::Log(Informative, PurposeLog, *this, "GoalComplete", TEXT("Ending %s"), *Event->GetName());
-				DataChunk<UTrackedPurposes>()->RemoveFromValue(indexOfStoredEvent);/// Then remove Event from Tracked Purposes
-			}
+			activeEvent->AdjustDataIfPossible(activeEvent->Purpose().DataAdjustments(), EPurposeSelectionEvent::OnFinished, EVENT, "GoalComplete", this);
+			//Global::Log(Informative, PurposeLog, *this, "GoalComplete", TEXT("Ending %s"), *Event->GetName());
+			contextTrees.Unregister(uniqueContextID);
+			trackedPurposes.Remove(uniqueContextID, eventAddress);/// Then remove Event from Tracked Purposes
 			break;
+		}
 		case (int)EPurposeLayer::Goal:
 			break;
 	}
 }
 
-TArray<FTaskLayer> ADirector_Level::GetTasksOfObjective(const FPurposeAddress& address)
+TArrayView<const FPurposeTreeNode> ADirector_Level::GetTasksOfObjective(const FPurposeAddress& address)
 {
-	int eventAddress = address.GetAddressForLayer((int)EPurposeLayer::Event);
-
-	if (!eventCacheForPurposeSystem.IsValidIndex(eventAddress))
-	{
-		Global::LogError(EVENT, GetName(), "GetSubPurposesFor", TEXT("Address %s not found for Event"), *address.GetAddressAsString());
-		return TArray<FTaskLayer>();
-	}
-	
-	TArray<FGoalLayer>& goals = eventCacheForPurposeSystem[eventAddress].goals;
-
-	int goalAddress = address.GetAddressForLayer((int)EPurposeLayer::Goal);
+	const FPurposeTreeNode* objective = purposeTree.IsValid() ? purposeTree->FindNode(address) : nullptr;
 
-	if (!goals.IsValidIndex(goalAddress))
+	/// The address may be that of a behavior, in which case we want the tasks of its parent
+	if (objective && objective->address.GetAddressLayer() == FPurposeAddress::MaxLayers)
 	{
-		Global::LogError(EVENT, GetName(), "GetSubPurposesFor", TEXT("Address %s not found for Event"), *address.GetAddressAsString());
-		return TArray<FTaskLayer>();
+		objective = purposeTree->ParentOf(*objective);
 	}
 
-	TArray<FObjectiveLayer>& objectives = goals[goalAddress].objectives;
-
-	int objectiveAddress = address.GetAddressForLayer((int)EPurposeLayer::Objective);
-
-	if (!objectives.IsValidIndex(objectiveAddress))
+	if (!objective)
 	{
-		Global::LogError(EVENT, GetName(), "GetSubPurposesFor", TEXT("Address %s not found for Event"), *address.GetAddressAsString());
-		return TArray<FTaskLayer>();
+		Global::LogError(EVENT, GetName(), "GetTasksOfObjective", TEXT("Address %s not found for Event"), *address.GetAddressAsString());
+		return TArrayView<const FPurposeTreeNode>();
 	}
 
-	TArray<FTaskLayer>& tasks = objectives[goalAddress].tasks;
-
-	return tasks;
+	return purposeTree->ChildrenOf(*objective);
 }
 
-bool ADirector_Level::GetGoalLayer(const FPurposeAddress& address, FGoalLayer& outGoal)
+const FEventLayer* ADirector_Level::FindEventLayer(const FPurposeAddress& address) const
 {
-	int eventAddress = address.GetAddressForLayer((int)EPurposeLayer::Event);
-
-	if (!eventCacheForPurposeSystem.IsValidIndex(eventAddress))
+	const FEventLayer* eventLayer = purposeTree.IsValid() ? purposeTree->FindEventLayer(address) : nullptr;
+	if (!eventLayer)
 	{
-		Global::LogError(EVENT, GetName(), "GetSubPurposesFor", TEXT("Address %s not found for Event"), *address.GetAddressAsString());
-		return false;
+		Global::LogError(EVENT, GetName(), "FindEventLayer", TEXT("Address %s not found for Event"), *address.GetAddressAsString());
 	}
+	return eventLayer;
+}
 
-	TArray<FGoalLayer>& goals = eventCacheForPurposeSystem[eventAddress].goals;
-
-	int goalAddress = address.GetAddressForLayer((int)EPurposeLayer::Goal);
-
-	if (!goals.IsValidIndex(goalAddress))
+const FGoalLayer* ADirector_Level::FindGoalLayer(const FPurposeAddress& address) const
+{
+	const FGoalLayer* goalLayer = purposeTree.IsValid() ? purposeTree->FindGoalLayer(address) : nullptr;
+	if (!goalLayer)
 	{
-		Global::LogError(EVENT, GetName(), "GetSubPurposesFor", TEXT("Address %s not found for Event"), *address.GetAddressAsString());
-		return false;
+		Global::LogError(EVENT, GetName(), "FindGoalLayer", TEXT("Address %s not found for Goal"), *address.GetAddressAsString());
 	}
-
-	outGoal = goals[goalAddress];
-	return true;
+	return goalLayer;
 }
 
-bool ADirector_Level::GetEventLayer(const FPurposeAddress& address, FEventLayer& outEvent)
+const FObjectiveLayer* ADirector_Level::FindObjectiveLayer(const FPurposeAddress& address) const
 {
-	int eventAddress = address.GetAddressForLayer((int)EPurposeLayer::Event);
-
-	if (!eventCacheForPurposeSystem.IsValidIndex(eventAddress))
+	const FObjectiveLayer* objectiveLayer = purposeTree.IsValid() ? purposeTree->FindObjectiveLayer(address) : nullptr;
+	if (!objectiveLayer)
 	{
-		Global::LogError(EVENT, GetName(), "GetSubPurposesFor", TEXT("Address %s not found for Event"), *address.GetAddressAsString());
-		return false;
+		Global::LogError(EVENT, GetName(), "FindObjectiveLayer", TEXT("Address %s not found for Objective"), *address.GetAddressAsString());
 	}
-
-	outEvent = eventCacheForPurposeSystem[eventAddress];
-	return true;
+	return objectiveLayer;
 }
 
-void ADirector_Level::EventAssetsLoaded()
+void ADirector_Level::LoadEventAssetsInBatches()
 {
 	UAssetManager* assetManager = GEngine->AssetManager;
 	if (!assetManager)
 	{
-		Global::LogError(MANAGEMENT, *this, "BeginPlay", TEXT("Asset manager invalid!"));
+		Global::LogError(MANAGEMENT, *this, "LoadEventAssetsInBatches", TEXT("Asset manager invalid!"));
 		return;
 	}
 
-	TSharedPtr<FStreamableHandle> callback = assetManager->LoadPrimaryAssetsWithType(UEventAsset::PrimaryAssetType());
-	//TSharedPtr<FStreamableHandle> callback = assetManager->GetPrimaryAssetDataList(UEventAsset::PrimaryAssetType());
+	TArray<FAssetData> eventAssetData;
+	assetManager->GetPrimaryAssetDataList(UEventAsset::PrimaryAssetType(), eventAssetData);
+	eventAssetData.Sort([](const FAssetData& a, const FAssetData& b) { return a.GetSoftObjectPath().ToString() < b.GetSoftObjectPath().ToString(); });
 
-	if (!callback)
+	/// Every slot is reserved up front, so the address of an Event is the same no matter which batch it arrives in
+	TMap<int32, TArray<FPrimaryAssetId>> batches;
+	for (const FAssetData& assetData : eventAssetData)
 	{
-		Global::LogError(PURPOSE, GetName(), "EventAssetsLoaded", TEXT("Callback to load EventAssets invalid!"));
+		eventRegistry.Reserve(assetData.GetSoftObjectPath());
+
+		int32 loadPriority = 0;
+		assetData.GetTagValue(GET_MEMBER_NAME_CHECKED(UEventAsset, loadPriority), loadPriority);
+		batches.FindOrAdd(loadPriority).Add(assetManager->GetPrimaryAssetIdForData(assetData));
+	}
+	batches.KeySort([](const int32 a, const int32 b) { return a > b; });
+
+	for (TPair<int32, TArray<FPrimaryAssetId>>& batch : batches)
+	{
+		Global::Log(DATADEBUG, PURPOSE, *this, "LoadEventAssetsInBatches", TEXT("Requesting %d Events of priority %d."), batch.Value.Num(), batch.Key);
+
+		TSharedPtr<FStreamableHandle> callback = assetManager->LoadPrimaryAssets(batch.Value, TArray<FName>(), FStreamableDelegate::CreateUObject(this, &ADirector_Level::EventBatchLoaded, batch.Value), batch.Key);
+		if (!callback)
+		{
+			Global::LogError(PURPOSE, *this, "LoadEventAssetsInBatches", TEXT("Callback to load EventAssets of priority %d invalid!"), batch.Key);
+		}
+	}
+}
+
+void ADirector_Level::EventBatchLoaded(TArray<FPrimaryAssetId> batch)
+{
+	UAssetManager* assetManager = GEngine->AssetManager;
+	if (!assetManager)
+	{
+		Global::LogError(MANAGEMENT, *this, "EventBatchLoaded", TEXT("Asset manager invalid!"));
 		return;
 	}
-	TArray<UObject*> assets;
-	callback->GetLoadedAssets(assets);
 
-	for (UObject* asset : assets)
+	for (const FPrimaryAssetId& assetId : batch)
 	{
-		if (IsValid(asset) && asset->IsA<UEventAsset>())
+		UEventAsset* asset = Cast<UEventAsset>(assetManager->GetPrimaryAssetObject(assetId));
+		if (!IsValid(asset))
 		{
-			eventCacheForPurposeSystem.Add(Cast<UEventAsset>(asset)->eventLayer);
+			Global::LogError(PURPOSE, *this, "EventBatchLoaded", TEXT("%s failed to load!"), *assetId.ToString());
+			continue;
 		}
+
+		eventRegistry.SetEvent(eventRegistry.Reserve(FSoftObjectPath(asset)), asset->eventLayer);
 	}
+
+	CompilePurposeTreeAsync();
 }
 
 void ADirector_Level::GoalComplete(const int64& uniqueContextID, const FPurposeAddress& addressOfGoal)
 {
-	for (TObjectPtr<AManager> manager : managers)
+	for (TScriptInterface<IPurposeManagementInterface> participant : contextTrees.ParticipantsOf(uniqueContextID))
 	{
-		manager->EndGoalsOfEvent(uniqueContextID, addressOfGoal);/// Tell every Manager to Remove their Goal that belongs to inContext->Parent() Event
+		if (AManager* manager = Cast<AManager>(participant.GetObject()))
+		{
+			manager->EndGoalsOfEvent(uniqueContextID, addressOfGoal);/// Tell every Manager holding a Goal of inContext->Parent() Event to remove it
+		}
 	}
 }
 
 void ADirector_Level::SeekActivitiesInLevel()
 {
 	Global::Log(CALLTRACEESSENTIAL, PURPOSE, *this, "SeekActivitiesInLevel", TEXT(""));
+
+	/// Every activity is registered before the tree is compiled once, rather than compiling per activity found
+	TArray<FContextData> activities;
 	for (TActorIterator<AAIActivity> ActorItr(GetWorld(), AAIActivity::StaticClass()); ActorItr; ++ActorItr)/// Find all AI Activity objects in level
 	{
 		////Global::Log( FULLTRACE, ManagementLog, *this, "SeekActivitiesInLevel", TEXT("Activity found."));
@@ -529,20 +589,34 @@ void ADirector_Level::SeekActivitiesInLevel()
 			/// Refactor: Purpose Events Activity AI; Instead of seeking purpose assets through AssetManager, Activities should have purpose layers established on them with EditInlineNew
 				/// This way we aren't creating Events and Goals that are irrelevant anywhere except that activity
 				/// But there should be an option for utilizing a global purpose 
-				/// Instead of putting the Event Asset throught purpose selection, simply add it to selected eventCacheForPurposeSystem
+				/// Instead of putting the Event Asset throught purpose selection, simply add it to selected eventRegistry
 				/// Currently, because we are loading in purpose assets, we simply are telling the activity to load the assets
 				/// Once loaded, the activity passes the Event back to the ADirector_Level for queuing in PurposeEvaluationThread
 			FContextData activityData = ActorItr->Activity();
 			activityData.AddSubject(ESubject::Instigator, this);
 
-			activityData.addressOfPurpose = eventCacheForPurposeSystem.Add(ActorItr->eventForActivity);/// We both need to store the activity for future potential occurrences
-			/// And we need to ensure the address of the activity is updated to match its index in the eventCacheForPurposeSystem cache
-			
-			ProvidePurposeToOwner(activityData);
-
-			PurposeSystem::QueueNextPurposeLayer(activityData);
+			activityData.addressOfPurpose = eventRegistry.Reserve(FSoftObjectPath(*ActorItr));
+			eventRegistry.SetEvent(activityData.addressOfPurpose, ActorItr->eventForActivity);/// We both need to store the activity for future potential occurrences
+			/// And we need to ensure the address of the activity is updated to match its slot in the eventRegistry
+			ActorItr->OnDestroyed.AddUniqueDynamic(this, &ADirector_Level::ActivityDestroyed);
+			activityContextIDs.Add(*ActorItr, activityData.GetContextID());
+			activities.Add(MoveTemp(activityData));
 		}
 	}
+
+	if (activities.Num() == 0)
+	{
+		return;
+	}
+
+	CompilePurposeTree();
+
+	for (FContextData& activityData : activities)
+	{
+		ProvidePurposeToOwner(activityData);
+
+		PurposeSystem::QueueNextPurposeLayer(activityData);
+	}
 }
 
 #pragma endregion
@@ -13,6 +13,12 @@
 #include "DataMapInterface.h"
 #include "AISpawn.h"
 #include "Engine/AssetManager.h"
+#include "Purpose/PurposeEventRegistry.h"
+#include "Purpose/PurposeTrackedPurposeStore.h"
+#include "Purpose/PurposeContextStore.h"
+#include "Purpose/PurposeContextTreeRegistry.h"
+#include "Purpose/PurposeSpatialGrid.h"
+#include "Purpose/PurposeComponentRegistry.h"
 #include "Director_Level.generated.h"
 
 UCLASS(NotPlaceable)
@@ -33,6 +39,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	/// Publishes the world state blackboard and recycles the data chunk pool once per tick
+	virtual void Tick(float DeltaTime) override;
 
 private:
 
@@ -42,8 +50,21 @@ private:
 
 	/// Force implementers to provide an editable datamap
 	/// The only way to the change the DataMap is through the Server RPCs
+	/// Free of side effects, as lookups pass through here too, the data map version is raised by AddData, AppendData and RemoveData instead
 	TArray<FDataMapEntry>& DataMapInternal() final { return data; }
 
+public:
+
+	/// Each also returns any pooled chunk removed or replaced to the data chunk pool
+	void AddData(UDataChunk* inData, bool overwriteValue = true) override;
+	void AppendData(const TArray<FDataMapEntry>& inDataMap, bool overwriteValue = true) override;
+	void RemoveData(TSubclassOf<UDataChunk> inClass) override;
+
+private:
+
+	/// Raised whenever the data map may have changed, allowing the blackboard to reuse its last copy until it does
+	uint32 dataMapVersion = 0;
+
 	UPROPERTY(Replicated)
 	/// Level Directors are responsible for providing managers with Event direction from within their level
 	TArray<TObjectPtr<class AManager>> managers;
@@ -64,6 +85,21 @@ public:
 
 	TArray<FPurposeEvaluationThread*> GetBackgroundPurposeThreads() final;
 
+	FPurposeBlackboard* GetWorldStateBlackboard() final { return &worldStateBlackboard; }
+
+	FDataChunkPool* GetDataChunkPool() final { return &dataChunkPool; }
+
+	FPurposeContextStore* GetContextStore() final { return &contextStore; }
+
+	FContextTreeRegistry* GetContextTreeRegistry() final { return &contextTrees; }
+
+	FPurposeSpatialGrid* GetSpatialGrid() final { return &spatialGrid; }
+
+	FPurposeComponentRegistry* GetPurposeComponentRegistry() final { return &purposeComponents; }
+
+	uint32 DataMapVersion() const final { return dataMapVersion; }
+	void IncrementDataMapVersion() final { ++dataMapVersion; }
+
 	TArray<TScriptInterface<IDataMapInterface>> GetCandidatesForSubPurposeSelection(const int PurposeLayerForUniqueSubjects) final;
 
 	/// @param PurposeLayerForUniqueSubjects: Represents the purpose layer for which the PurposeOwner is meant to create new FUniqueSubjectMaps
@@ -75,19 +111,21 @@ public:
 	bool ProvidePurposeToOwner(const FContextData& purposeToStore) final;
 
 	/// Events must be stored globally for the duration of a game so that they may have a consistent PurposeAddress
-	TArray<FPurpose> GetEventAssets() final;
-
-	/// As FPurpose can not hold an variable or TArray<> of itself, we're forced to workaround simply accessing subpurposes
-	TArray<FPurpose> GetSubPurposesFor(FPurposeAddress address) final;
+	FCompiledPurposeTreePtr GetPurposeTree() final { return purposeTree; }
 
 	/// When a purpose is put up for selection, but it appears to be a duplicate of a current purpose, we want to let the purpose owner handle the reoccurrence
 	void PurposeReOccurrence(const FPurposeAddress addressOfPurpose, const int64 uniqueIDofActivePurpose) final;
 
+	/// Completion is only checked for Objectives, by their candidates
+	void CompletionEvaluated(const int64 uniqueContextID, const FPurposeAddress& addressOfPurpose, const EPurposeState status) final {}
+
 	/// @param uniqueIdentifierOfContextTree: This ID unique to a series of context datas starting with Event allows separation of same purposes for different contexts
 	/// @param fullAddress: Tying the address to the unique ID is how we can search stored contexts for the relevant context we seek
 	/// @param layerToRetrieveFor: We may not necessarily wish to find the end address of the fullAddress, so we can indicate a layer to seek out
-	/// @return FContextData&: Need to check for validity as the context data may not have been found and an empty struct returned
-	FContextData& GetStoredPurpose(const int64 uniqueIdentifierOfContextTree, const FPurposeAddress& fullAddress, const int layerToRetrieveFor) final;
+	/// @return FContextData*: The stored context itself, nullptr if it was not found
+	FContextData* GetStoredPurpose(const int64 uniqueIdentifierOfContextTree, const FPurposeAddress& fullAddress, const int layerToRetrieveFor) final;
+
+	void StoredPurposeChanged(const FContextData& storedContext) final { trackedPurposes.ContextChanged(storedContext); }
 
 	/// @param parentAddress: An address which is either that of a purpose containing behaviors so that it may reference the parent, or the parent address itself
 	/// @param TArray<TObjectPtr<UGA_Behavior>>: All the behaviors contained by the parent indicated
@@ -98,7 +136,7 @@ public:
 	TObjectPtr<class UBehavior_AI> GetBehaviorAtAddress(const FPurposeAddress& inAddress) final;
 
 	///@return bool: True when the Target+Action are the same
-	bool DoesPurposeAlreadyExist(const FContextData& primary, const FSubjectMap& secondarySubjects, const TArray<FDataMapEntry>& secondaryContext, const FPurposeAddress optionalAddress = FPurposeAddress()) final;
+	bool DoesPurposeAlreadyExist(const FContextData& primary, const FSubjectMap& secondarySubjects, const TArray<FDataMapEntry>& secondaryContext, const FInlineDataMap& secondaryValues, const FPurposeAddress optionalAddress = FPurposeAddress()) final;
 
 	void SubPurposeCompleted(const int64& uniqueContextID, const FPurposeAddress& addressOfPurpose);
 
@@ -106,18 +144,24 @@ public:
 
 
 	/// As purposes of FContextData are stored as FPurpose, we have no reference to sub purposes or what they actually are
-	///@return TArray<FTaskLayer>: So we trace the address from Event to the Objective and return it's sub tasks
-	TArray<FTaskLayer> GetTasksOfObjective(const FPurposeAddress& address);
+	///@return TArrayView<const FPurposeTreeNode>: So we find the Objective in the purpose tree and return it's sub tasks, valid for as long as the current purposeTree
+	TArrayView<const FPurposeTreeNode> GetTasksOfObjective(const FPurposeAddress& address);
 
 	/// As purposes of FContextData are stored as FPurpose, we have no reference to sub purposes or what they actually are
-	///@return TArray<FTaskLayer>: So we trace the address from Event to the Objective and return it's sub tasks
-	bool GetGoalLayer(const FPurposeAddress& address, FGoalLayer& outGoal);
-	
-	/// As purposes of FContextData are stored as FPurpose, we have no reference to sub purposes or what they actually are
-	///@return TArray<FTaskLayer>: So we trace the address from Event to the Objective and return it's sub tasks
-	bool GetEventLayer(const FPurposeAddress& address, FEventLayer& outEvent);
+	/// So we find the layer the address belongs to within the purpose tree
+	/// Valid until the purpose tree is next compiled, so should not be held beyond the current call
+	///@return nullptr when the address is not found
+	const FEventLayer* FindEventLayer(const FPurposeAddress& address) const;
+	const FGoalLayer* FindGoalLayer(const FPurposeAddress& address) const;
+	const FObjectiveLayer* FindObjectiveLayer(const FPurposeAddress& address) const;
+
+	/// Reserves a slot for every Event asset, ordered by path so that addresses never depend on load order
+	/// Then requests each batch of equal loadPriority, highest first
+	void LoadEventAssetsInBatches();
 
-	void EventAssetsLoaded();
+	/// Moves the Events of a single batch into their reserved slots and compiles them into the purpose tree in the background
+	/// @param batch: The assets of the batch, all of which are loaded
+	void EventBatchLoaded(TArray<FPrimaryAssetId> batch);
 
 	void GoalComplete(const int64& uniqueContextID, const FPurposeAddress& addressOfGoal);
 
@@ -130,13 +174,64 @@ public:
 
 protected:
 
+	/// Every Event selected, until all of its Goals are complete
 	/// Stored as a copy since the background threads are who create the context data
-	/// So long as we have purpose address and unique context ids, it's not a big deal. Each context data is pretty data lightweight
-	TArray<FContextData> eventsActive;
+	/// GetStoredPurpose hands out pointers into it, so it must not be copied
+	/// Mirrored into our UTrackedPurposes chunk from BeginPlay
+	FTrackedPurposeStore trackedPurposes;
 
 	/// Stored as a copy because FEventLayer can come from any source potentially, from UDataAsset to AActor
 	/// They aren't important, only the chain of purpose and their Conditions are
-	TArray<FEventLayer> eventCacheForPurposeSystem;
+	/// Keyed by the hashed path of the asset or activity each Event came from
+	FEventRegistry eventRegistry;
+
+	/// Frees the slots of released Events no longer referenced by any tracked context, checked each tick while any are pending
+	void UnloadUnreferencedEvents();
+
+	UFUNCTION()
+	/// Untracks the activity's own Event context and releases its Event, as with level streaming the activity may be gone long before the session ends
+	void ActivityDestroyed(AActor* activity);
+
+	/// The context ID each activity's Event is tracked under by SeekActivitiesInLevel
+	TMap<TObjectKey<AActor>, int64> activityContextIDs;
+
+	/// eventRegistry compiled into a flat tree, recompiled whenever an Event is stored or unloaded
+	/// Every potential purpose holds the tree it came from, so replacing it never invalidates an evaluation in progress
+	FCompiledPurposeTreePtr purposeTree;
+
+	/// Must be called on the game thread whenever eventRegistry changes
+	void CompilePurposeTree();
+
+	/// As CompilePurposeTree, but compiled on a background thread and swapped in on the game thread once done
+	/// purposeTree remains the previous tree until then, so occurrences simply continue with the Events already resident
+	void CompilePurposeTreeAsync();
+
+	/// Game thread only, ignores any tree older than the one already in use
+	void PurposeTreeCompiled(const uint32 generation, FCompiledPurposeTreePtr compiledTree);
+
+	/// Raised for every compile, so a slow background compile never replaces a newer tree
+	uint32 purposeTreeGeneration = 0;
+	uint32 appliedPurposeTreeGeneration = 0;
+
+	/// Every Manager and PurposeAbilityComponent registers their data map here
+	/// Once per tick it is published, so the background threads read a stable copy of the world rather than each request copying its subjects
+	FPurposeBlackboard worldStateBlackboard;
+
+	UPROPERTY()
+	/// Chunks created within our data map by data adjustments, recycled as they are removed or replaced
+	FDataChunkPool dataChunkPool;
+
+	/// Contexts held by handle, such as the current objective of each purpose component
+	FPurposeContextStore contextStore;
+
+	/// Every Event context in trackedPurposes, by ID, with the managers tracking Goals beneath it
+	FContextTreeRegistry contextTrees;
+
+	/// Every purpose component by the location of its avatar, for targeting which needs no EQS query
+	FPurposeSpatialGrid spatialGrid;
+
+	/// Every actor standing for a purpose component, so targeting resolves each actor found with a single lookup
+	FPurposeComponentRegistry purposeComponents;
 
 private:
 
@@ -193,11 +288,13 @@ private:
 	{
 		////Global::Log(Debug, Purpose, *this, "Init", TEXT("Creating Event thread."));
 		eventThread = new FEventThread(ObjectiveQueue, GoalQueue, OccurrenceQueue);
+		eventThread->blackboard = &worldStateBlackboard;
 		eventThread->stopThread = false;
 		currentEventThread = FRunnableThread::Create(eventThread, TEXT("Event Thread"));
 
 		////Global::Log(Debug, Purpose, *this, "Init", TEXT("Creating Actor thread."));
 		actorThread = new FActorThread(ReactionQueue, TasksQueue);
+		actorThread->blackboard = &worldStateBlackboard;
 		actorThread->stopThread = false;
 		currentActorThread = FRunnableThread::Create(actorThread, TEXT("Actor Thread"));
 	}
@@ -87,6 +87,16 @@ public:
 
 };
 
+UENUM(BlueprintType)
+/// <summary>
+/// How FTargetingParameters finds its targets
+/// </summary>
+enum class ETargetingMethod : uint8
+{
+	Query,/// Runs targetingQuery, for targeting which needs the full flexibility of EQS
+	Native/// Reads the director's spatial grid of purpose components, for simple radius and group targeting
+};
+
 USTRUCT(BlueprintType)
 struct FTargetingParameters
 {
@@ -96,15 +106,27 @@ struct FTargetingParameters
 	{
 	}
 
-	UPROPERTY(EditAnywhere, DisplayName = "Query to find targets for Purpose")
+	UPROPERTY(EditAnywhere)
+		ETargetingMethod targetingMethod = ETargetingMethod::Query;
+
+	UPROPERTY(EditAnywhere, DisplayName = "Query to find targets for Purpose", meta = (EditCondition = "targetingMethod == ETargetingMethod::Query", EditConditionHides))
 		TObjectPtr<class UEnvQuery> targetingQuery = nullptr;
 
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "targetingMethod == ETargetingMethod::Native", EditConditionHides, ClampMin = "0"))
+		/// Targets are sought within this distance of targetLocation, or of the candidate if there is none
+		float radius = 2000.f;
+
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "targetingMethod == ETargetingMethod::Native", EditConditionHides))
+		/// When set, only targets whose group of the Event holds this relationship to the Goal's group are found
+		EGroupRelationship groupRelationship = EGroupRelationship::None;
+
 	UPROPERTY(EditAnywhere, DisplayName = "Optional Subject Location Radius")
 		/// Subject will be sought in ContextData, and ActorLocation will be sought for subject
 		ESubject targetLocation = ESubject::None;
 
 	UPROPERTY(EditAnywhere, DisplayName = "Intent against Group")
 		/// Rather than a direct action between individuals, this allows us to generalize to an objective level of action without committing to a specific task
+		/// Natively targeted Objectives with an intent only find targets belonging to a group of the Event
 		EIntentTowardsGroup intent = EIntentTowardsGroup::None;
 };
 
@@ -120,6 +142,10 @@ public:
 
 	UPROPERTY(EditAnywhere, meta = (DisplayPriority = "1"))
 	FTargetingParameters targetingParams;
+
+	UPROPERTY(EditAnywhere, meta = (DisplayPriority = "2", ClampMin = "0"))
+	/// How many candidates of a manager may take this Objective at once when the manager assigns Objectives jointly, 0 for no limit
+	int32 maxParticipants = 0;
 };
 
 USTRUCT(BlueprintType)
@@ -146,12 +172,43 @@ public:
 	/// So the first Goal is GroupA, and the second Goal is GroupB
 	TArray<FGroupRelationship> GroupRelationships;
 
-	EEventGroup GroupingForGoal(FPurposeAddress inGoal)
+	/// GroupA through GroupJ
+	static constexpr int32 NumGroups = 10;
+
+	/// Fills relationshipMatrix from GroupRelationships, in both directions
+	/// Called once as the Event is registered, see FRegisteredEvent, after which RelationshipBetweenGroups never searches GroupRelationships
+	void CompileRelationshipMatrix()
+	{
+		for (EGroupRelationship& relationship : relationshipMatrix)
+		{
+			relationship = EGroupRelationship::None;
+		}
+
+		for (const FGroupRelationship& grouping : GroupRelationships)
+		{
+			const int32 group1 = (int32)grouping.group1;
+			const int32 group2 = (int32)grouping.group2;
+			if (group1 >= NumGroups || group2 >= NumGroups)
+			{
+				continue;/// EEventGroup::None
+			}
+
+			/// A relationship declared in the given order wins over one declared in reverse, as it did when searching
+			relationshipMatrix[group1 * NumGroups + group2] = grouping.relationship;
+			if (!GroupRelationships.Contains(FGroupRelationship(grouping.group2, grouping.group1)))
+			{
+				relationshipMatrix[group2 * NumGroups + group1] = grouping.relationship;
+			}
+		}
+		bRelationshipMatrixCompiled = true;
+	}
+
+	EEventGroup GroupingForGoal(const FPurposeAddress& inGoal) const
 	{
 		//int32 goalIndex = goals.IndexOfByKey(inGoal.GetAddressOfThisPurpose());
 		int32 goalIndex = inGoal.GetAddressOfThisPurpose();
 
-		if (goals.IsValidIndex(goalIndex))
+		if (!goals.IsValidIndex(goalIndex))
 		{
 			Global::LogError(PURPOSE, "FEventLayer", "GroupingForGoal", TEXT("GoalIndex: %d not found!."), goalIndex);
 			return EEventGroup::None;
@@ -160,16 +217,21 @@ public:
 		return (goalIndex == INDEX_NONE || goalIndex <= -1) ? EEventGroup::None : StaticCast<EEventGroup>(goalIndex);
 	}
 
-	EGroupRelationship RelationshipBetweenGroups(EEventGroup group1, EEventGroup group2)
+	EGroupRelationship RelationshipBetweenGroups(EEventGroup group1, EEventGroup group2) const
 	{
+		if (bRelationshipMatrixCompiled)
+		{
+			return ((int32)group1 < NumGroups && (int32)group2 < NumGroups) ? relationshipMatrix[(int32)group1 * NumGroups + (int32)group2] : EGroupRelationship::None;
+		}
+
 		//Global::Log(FULLTRACE, PurposeLog, *this, "RelationshipBetweenGroups", TEXT("Seeking Groups: %s & %s."), *Global::EnumValueOnly<EEventGroup>(group1), *Global::EnumValueOnly<EEventGroup>(group2));
 
-		if (FGroupRelationship* grouping = GroupRelationships.FindByKey(FGroupRelationship(group1, group2)))
+		if (const FGroupRelationship* grouping = GroupRelationships.FindByKey(FGroupRelationship(group1, group2)))
 		{
 			//Global::Log(FULLTRACE, PurposeLog, *this, "RelationshipBetweenGroups", TEXT("Grouping found! %s."), *Global::EnumValueOnly<EGroupRelationship>(grouping->relationship));
 			return grouping->relationship;
 		}
-		else if (FGroupRelationship* grouping2 = GroupRelationships.FindByKey(FGroupRelationship(group2, group1)))/// In the case that group relatinship is declared in reverse
+		else if (const FGroupRelationship* grouping2 = GroupRelationships.FindByKey(FGroupRelationship(group2, group1)))/// In the case that group relatinship is declared in reverse
 		{
 			//Global::Log(FULLTRACE, PurposeLog, *this, "RelationshipBetweenGroups", TEXT("Grouping found! %s."), *Global::EnumValueOnly<EGroupRelationship>(grouping2->relationship));
 			return grouping2->relationship;
@@ -177,6 +239,13 @@ public:
 
 		return EGroupRelationship::None;
 	}
+
+private:
+
+	/// Indexed by group1 * NumGroups + group2
+	EGroupRelationship relationshipMatrix[NumGroups * NumGroups];
+
+	bool bRelationshipMatrixCompiled = false;
 };
 
 UCLASS()
@@ -193,6 +262,11 @@ public:
 	UPROPERTY(EditAnywhere)
 	FEventLayer eventLayer;
 
+	UPROPERTY(EditAnywhere, AssetRegistrySearchable)
+	/// Events are streamed in batches of equal priority, highest first
+	/// Occurrences only consider the Events already loaded, so anything that must react immediately should be given a higher priority
+	int32 loadPriority = 0;
+
 	/// Static definitions to establish consistency when seeking assets
 	/// Event and Reaction are the only two types an asset manager will need to discover
 	/// All other asset types are contained by Event Structure
@@ -56,6 +56,7 @@ AManager::AManager()
 void AManager::BeginPlay()
 {
 	Super::BeginPlay();
+	dataChunkPool.Initialize(this);
 	/*//Global::Log(FULLTRACE, ManagementLog, *this, "BeginPlay(AManager)", TEXT("NetMode: %s. NetOwner: %s. Owner: %s. World->FirstPlayerController: %s."), 
 		*Global::NetModeAsString(GetNetMode()), 
 		IsValid(GetNetOwner()) ? *GetNetOwner()->GetName() : TEXT("Invalid"), 
@@ -68,13 +69,23 @@ void AManager::BeginPlay()
 	}
 
 	timeSinceLastEQS = GetWorld()->GetTime();
+	targetQueryCache.lifetime = targetQueryCacheLifetime;
+
+	if (HasAuthority())/// Clients receive the chunk through replication
+	{
+		if (!HasData(UTrackedPurposes::StaticClass()))
+		{
+			AddData(NewObject<UTrackedPurposes>(this));
+		}
+		trackedPurposes.BindView(DataChunk<UTrackedPurposes>());
+	}
 }
 
 void AManager::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	/// Here we list the variables we want to replicate + a condition if wanted
-	DOREPLIFETIME(AManager, data);
+	DOREPLIFETIME(AManager, replicatedData);
 	DOREPLIFETIME(AManager, actors);
 }
 
@@ -84,12 +95,81 @@ void AManager::BeginDestroy()
 	
 }
 
+void AManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (IsValid(director))
+	{
+		director->GetWorldStateBlackboard()->UnregisterEntity(this);
+
+		if (FContextTreeRegistry* registry = GetContextTreeRegistry())/// Completions and re-occurrences of our Goals' Events must no longer reach us
+		{
+			for (const int64 contextID : trackedPurposes.ContextTreeIDs())
+			{
+				registry->RemoveParticipant(contextID, this);
+			}
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AManager::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	replicatedData.SyncFrom(data, dataMapVersion);
+}
+
+void AManager::OnRep_ReplicatedData()
+{
+	replicatedData.CopyTo(DataMapInternal());
+	IncrementDataMapVersion();
+}
+
+void AManager::AddData_Implementation(UDataChunk* inData, bool overwriteValue)
+{
+	UDataChunk* replaced = IsValid(inData) && HasData(inData->GetClass()) ? DataChunk(inData->GetClass()) : nullptr;
+	IDataMapInterface::AddData(inData, overwriteValue);
+	IncrementDataMapVersion();
+	ReleaseDataChunk(replaced);/// Does nothing unless the chunk was actually replaced
+}
+
+void AManager::AppendData_Implementation(const TArray<FDataMapEntry>& inDataMap, bool overwriteValue)
+{
+	TArray<UDataChunk*> replaced;
+	for (const FDataMapEntry& entry : inDataMap)
+	{
+		if (IsValid(entry.Chunk) && HasData(entry.Chunk->GetClass()))
+		{
+			replaced.Add(DataChunk(entry.Chunk->GetClass()));
+		}
+	}
+
+	IDataMapInterface::AppendData(inDataMap, overwriteValue);
+	IncrementDataMapVersion();
+
+	for (UDataChunk* chunk : replaced)
+	{
+		ReleaseDataChunk(chunk);
+	}
+}
+
+void AManager::RemoveData_Implementation(TSubclassOf<UDataChunk> inClass)
+{
+	UDataChunk* removed = HasData(inClass) ? DataChunk(inClass) : nullptr;
+	IDataMapInterface::RemoveData(inClass);
+	IncrementDataMapVersion();
+	ReleaseDataChunk(removed);
+}
+
 // Called every frame
 void AManager::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
 	PerformVisualEQS();
+
+	targetQueryCache.RemoveExpired(GetWorld()->GetTimeSeconds());
 }
 
 #pragma region Purpose
@@ -109,6 +189,41 @@ TArray<FPurposeEvaluationThread*> AManager::GetBackgroundPurposeThreads()
 	return GetHeadOfPurposeManagment()->GetBackgroundPurposeThreads();
 }
 
+FPurposeBlackboard* AManager::GetWorldStateBlackboard()
+{
+	return GetHeadOfPurposeManagment()->GetWorldStateBlackboard();
+}
+
+FPurposeContextStore* AManager::GetContextStore()
+{
+	return GetHeadOfPurposeManagment()->GetContextStore();
+}
+
+FContextTreeRegistry* AManager::GetContextTreeRegistry()
+{
+	return GetHeadOfPurposeManagment()->GetContextTreeRegistry();
+}
+
+FPurposeSpatialGrid* AManager::GetSpatialGrid()
+{
+	return GetHeadOfPurposeManagment()->GetSpatialGrid();
+}
+
+FPurposeComponentRegistry* AManager::GetPurposeComponentRegistry()
+{
+	return GetHeadOfPurposeManagment()->GetPurposeComponentRegistry();
+}
+
+void AManager::EstablishAccessToPurposeThreads(TObjectPtr<ADirector_Level> inDirector)
+{
+	director = inDirector;
+
+	if (IsValid(director))
+	{
+		director->GetWorldStateBlackboard()->RegisterEntity(this);
+	}
+}
+
 TArray<TScriptInterface<IDataMapInterface>> AManager::GetCandidatesForSubPurposeSelection(const int PurposeLayerForUniqueSubjects)
 {
 	TArray<TScriptInterface<IDataMapInterface>> candidates;
@@ -149,32 +264,24 @@ TArray<FSubjectMap> AManager::GetUniqueSubjectsRequiredForSubPurposeSelection(co
 	{
 		case (int)EPurposeLayer::Objective:
 
-			FGoalLayer goal;
-			if (!director->GetGoalLayer(addressOfSubPurpose, goal))
-			{
-				Global::LogError(OBJECTIVE, *this, "GetUniqueSubjectsRequiredForSubPurposeSelection", TEXT("Could not get goal for address %s, layer %s")
-					, *addressOfSubPurpose.GetAddressAsString()
-					, *Global::EnumValueOnly<EPurposeLayer>(PurposeLayerForUniqueSubjects)
-				);
-				return uniqueSubjects;
-			}
-
-			if (!goal.objectives.IsValidIndex(addressOfSubPurpose.GetAddressOfThisPurpose()))
+			/// We are retrieving all potential subjects for a specific purpose
+				/// In this case it's for an Objective
+			const FObjectiveLayer* objective = IsValid(director) ? director->FindObjectiveLayer(addressOfSubPurpose) : nullptr;
+			if (!objective)
 			{
-				Global::LogError(OBJECTIVE, *this, "GetUniqueSubjectsRequiredForSubPurposeSelection", TEXT("Could not get objective of goal %s for address %s, layer %s")
-					, *goal.descriptionOfPurpose
+				Global::LogError(OBJECTIVE, *this, "GetUniqueSubjectsRequiredForSubPurposeSelection", TEXT("Could not get objective for address %s, layer %s")
 					, *addressOfSubPurpose.GetAddressAsString()
 					, *Global::EnumValueOnly<EPurposeLayer>(PurposeLayerForUniqueSubjects)
 				);
 				return uniqueSubjects;
 			}
 
-			/// We are retrieving all potential subjects for a specific purpose
-				/// In this case it's for an Objective
-			const FObjectiveLayer& objective = goal.objectives[addressOfSubPurpose.GetAddressOfThisPurpose()];
+			/// Candidates are purpose components, so targeting is from their avatar
+			UPurposeAbilityComponent* candidateComponent = Cast<UPurposeAbilityComponent>(candidate.GetObject());
+			TObjectPtr<AActor> source = candidateComponent ? candidateComponent->GetAvatarActor() : Cast<AActor>(candidate.GetObject());
 
 			/// So we get every potential target for the objective
-			TArray<TScriptInterface<IDataMapInterface>> targets = PotentialObjectiveTargets(Cast<AActor>(candidate.GetObject()), parentContext, objective.targetingParams);
+			TArray<TScriptInterface<IDataMapInterface>> targets = PotentialObjectiveTargets(source, parentContext, objective->targetingParams);
 			for (TScriptInterface<IDataMapInterface> target : targets)
 			{
 				/// And combine them with the candidate to form a UniqueSubject entry
@@ -200,9 +307,18 @@ bool AManager::ProvidePurposeToOwner(const FContextData& purposeToStore)
 	switch (purposeToStore.addressOfPurpose.GetAddressLayer())
 	{
 		case (int)EPurposeLayer::Goal:
-			if (!DataChunk<UTrackedPurposes>()->Value().Contains(purposeToStore))/// Because there may be a callback to this method for loading Goals
+			if (trackedPurposes.Add(purposeToStore))/// Because there may be a callback to this method for loading Goals, this fails if already tracked
 			{
-				DataChunk<UTrackedPurposes>()->AddToValue(purposeToStore);///Ensure that selected context is tracked
+				if (FContextTreeRegistry* registry = GetContextTreeRegistry())
+				{
+					registry->AddParticipant(purposeToStore.GetContextID(), this);/// So completion and re-occurrence of the Event reach us without asking every manager
+				}
+
+				const int32 goalIndex = purposeToStore.addressOfPurpose.GetAddressOfThisPurpose();/// Groups are dictated by the index of the Goal
+				if (goalIndex >= 0 && goalIndex < FEventLayer::NumGroups)/// An unset address has no group, and shifting by it would be undefined
+				{
+					groupMembership.FindOrAdd(purposeToStore.GetContextID()) |= 1 << goalIndex;
+				}
 				Global::Log(DATADEBUG, EVENT, *this, "ProvidePurposeToOwner", TEXT("Adding Purpose: %s; Description: %s")
 					, *purposeToStore.GetName()
 					, *purposeToStore.Description()
@@ -220,72 +336,66 @@ bool AManager::ProvidePurposeToOwner(const FContextData& purposeToStore)
 	return false;
 }
 
-TArray<FPurpose> AManager::GetEventAssets()
-{
-	return GetHeadOfPurposeManagment()->GetEventAssets();
-}
-
-TArray<FPurpose> AManager::GetSubPurposesFor(FPurposeAddress address)
+FCompiledPurposeTreePtr AManager::GetPurposeTree()
 {
-	return GetHeadOfPurposeManagment()->GetSubPurposesFor(address);
+	return GetHeadOfPurposeManagment()->GetPurposeTree();
 }
 
 void AManager::PurposeReOccurrence(const FPurposeAddress addressOfPurpose, const int64 uniqueIDofActivePurpose)
 {
 }
 
-FContextData& AManager::GetStoredPurpose(const int64 uniqueIdentifierOfContextTree, const FPurposeAddress& fullAddress, const int layerToRetrieveFor)
+FContextData* AManager::GetStoredPurpose(const int64 uniqueIdentifierOfContextTree, const FPurposeAddress& fullAddress, const int layerToRetrieveFor)
 {
 	switch (layerToRetrieveFor)
 	{
 		case (int)EPurposeLayer::Goal:
 
-			for (FContextData& context : DataChunk<UTrackedPurposes>()->ValueNonConst())
+			if (FContextData* context = trackedPurposes.FindForLayer(uniqueIdentifierOfContextTree, fullAddress, layerToRetrieveFor))
 			{
-				if (context.GetContextID() == uniqueIdentifierOfContextTree && context.addressOfPurpose.GetAddressForLayer(layerToRetrieveFor) == fullAddress.GetAddressForLayer(layerToRetrieveFor))
-				{
-					return context;
-				}
+				return context;
 			}
 			break;
 	}
 	return GetPurposeSuperior()->GetStoredPurpose(uniqueIdentifierOfContextTree, fullAddress, layerToRetrieveFor);
 }
 
-void AManager::ReevaluateObjectivesForAllCandidates(const FPurposeAddress& addressOfPurpose, const int64& uniqueIDofActivePurpose)
+void AManager::StoredPurposeChanged(const FContextData& storedContext)
 {
-	if (!HasData(UTrackedPurposes::StaticClass()))
+	if (!trackedPurposes.ContextChanged(storedContext))
 	{
-		Global::LogError(MANAGEMENT, *this, "ReevaluateObjectivesForAllCandidates", TEXT("Manager has no Tracked Purposes."));
-		return;
+		GetPurposeSuperior()->StoredPurposeChanged(storedContext);
 	}
-	for (const FContextData& goal : DataChunk<UTrackedPurposes>()->Value())
-	{
-		if (goal.GetContextID() != uniqueIDofActivePurpose)
-		{
-			continue;
-		}
+}
+
+void AManager::ReevaluateObjectivesForAllCandidates(const FPurposeAddress& addressOfPurpose, const int64& uniqueIDofActivePurpose)
+{
+	targetQueryCache.InvalidateContext(uniqueIDofActivePurpose);/// Reevaluation follows a change of the world, so targets are found anew
 
-		Global::Log(DATAESSENTIAL, GOAL, *this, "ReevaluateObjectiveForAllCandidates", TEXT("Reevaluating Objectives of %s"), *goal.GetName());
-		PurposeSystem::QueueNextPurposeLayer(goal);
+	for (const FContextData* goal : trackedPurposes.ContextsOf(uniqueIDofActivePurpose))
+	{
+		Global::Log(DATAESSENTIAL, GOAL, *this, "ReevaluateObjectiveForAllCandidates", TEXT("Reevaluating Objectives of %s"), *goal->GetName());
+		PurposeSystem::QueueNextPurposeLayer(*goal);
 	}
 }
 
 void AManager::EndGoalsOfEvent(const int64& uniqueContextID, const FPurposeAddress& eventAddress)
 {
-	if (HasData(UTrackedPurposes::StaticClass()))
+	groupMembership.Remove(uniqueContextID);
+	targetQueryCache.InvalidateContext(uniqueContextID);
+
+	if (trackedPurposes.Num() > 0)
 	{
 		int addressOfEvent = eventAddress.GetAddressForLayer((int)EPurposeLayer::Event);
-		for (int i = DataChunk<UTrackedPurposes>()->Value().Num(); i > -1; --i )
+		for (const FContextData* goal : trackedPurposes.ContextsOf(uniqueContextID))/// Every context of the tree belongs to the same Event
 		{
-			const FContextData& goal = DataChunk<UTrackedPurposes>()->Value()[i];
+			goal->AdjustDataIfPossible(goal->Purpose().DataAdjustments(), EPurposeSelectionEvent::OnFinished, GOAL, "EndTrackedGoals", this);
+		}
+		trackedPurposes.RemoveContextTree(uniqueContextID);
 
-			if (uniqueContextID == goal.GetContextID() && eventAddress == goal.addressOfPurpose.GetAddressForLayer((int)EPurposeLayer::Event))
-			{
-				goal.AdjustDataIfPossible(goal.purpose.DataAdjustments(), EPurposeSelectionEvent::OnFinished, GOAL, "EndTrackedGoals", this);
-				//DataChunk<UTrackedPurposes>()->RemoveFromValue(goal);
-				DataChunk<UTrackedPurposes>()->RemoveFromValue(i);
-			}
+		if (FContextTreeRegistry* registry = GetContextTreeRegistry())
+		{
+			registry->RemoveParticipant(uniqueContextID, this);
 		}
 
 		/// Now check every candidate, and if they have an Objective that falls under a removed Goal, tell them to get new 
@@ -323,6 +433,12 @@ TArray<TScriptInterface<IDataMapInterface>> AManager::PotentialObjectiveTargets(
 			outDataMaps.Add(inGoal.DataMapInterfaceForSubject(ESubject::EventTarget));
 		}
 
+		if (targetingParams.targetingMethod == ETargetingMethod::Native)
+		{
+			outDataMaps.Append(NativeObjectiveTargets(source, inGoal, targetingParams));
+			return outDataMaps;
+		}
+
 		if (!targetingParams.targetingQuery)
 		{
 			Global::Log(DATADEBUG, OBJECTIVE, *this, "PotentialObjectiveTargets", TEXT("Targeting query invalid under goal %s!"), *inGoal.GetPurposeChainName());
@@ -335,84 +451,333 @@ TArray<TScriptInterface<IDataMapInterface>> AManager::PotentialObjectiveTargets(
 			UE_LOG(LogEQS, Warning, TEXT("Missing EQS manager!"));
 			return outDataMaps;
 		}
+		if (targetsOfBatchBeingQueued)/// The query has already run for this Goal, see GatherSubjectsForSubPurposeSelection
+		{
+			if (const TArray<TScriptInterface<IDataMapInterface>>* targets = targetsOfBatchBeingQueued->Find(targetingParams.targetingQuery.Get()))
+			{
+				outDataMaps.Append(*targets);
+				return outDataMaps;
+			}
+		}
+
+		const FTargetQueryKey cacheKey(targetingParams.targetingQuery.Get(), this, inGoal.GetContextID());
+		const double now = GetWorld()->GetTimeSeconds();
+		if (targetQueryCache.Find(cacheKey, now, outDataMaps))
+		{
+			return outDataMaps;
+		}
+
 		FEnvQueryRequest QueryRequest(targetingParams.targetingQuery, this);
 
 		TSharedPtr<FEnvQueryResult> result = EnvQueryManager->RunInstantQuery(QueryRequest, EEnvQueryRunMode::AllMatching);
 
-		if (!result.IsValid() && result->Items.Num() <= 0) { return outDataMaps; }
+		if (!result.IsValid() || !result->IsSuccessful()) { return outDataMaps; }/// A failed query is not cached, so it is retried
+
+		TArray<TScriptInterface<IDataMapInterface>> targets = TargetsFromQueryResult(*result);/// Cached even when empty, so a query finding nothing is not run again for every candidate
+		targetQueryCache.Add(cacheKey, now, targets);
+		outDataMaps.Append(targets);
+		return outDataMaps;
+	}
+	else
+	{
+		Global::LogError(OBJECTIVE, *this, "PotentialObjectiveTargets", TEXT("Source or World are nullptr!"));
+	}
+
+	return TArray< TScriptInterface<IDataMapInterface> >();
+}
+
+TArray<TScriptInterface<IDataMapInterface>> AManager::NativeObjectiveTargets(TObjectPtr<AActor> source, const FContextData& inGoal, const FTargetingParameters& targetingParams)
+{
+	TArray<TScriptInterface<IDataMapInterface>> outDataMaps;
+
+	FPurposeSpatialGrid* grid = GetSpatialGrid();
+	if (!grid)
+	{
+		Global::LogError(OBJECTIVE, *this, "NativeObjectiveTargets", TEXT("No spatial grid to target from!"));
+		return outDataMaps;
+	}
 
-		for (int i = 0; i < result->Items.Num(); ++i)
+	FVector center = source->GetActorLocation();
+	if (targetingParams.targetLocation != ESubject::None && inGoal.HasSubject(targetingParams.targetLocation))
+	{
+		UObject* subject = inGoal.DataMapInterfaceForSubject(targetingParams.targetLocation).GetObject();
+		if (!grid->LocationOf(subject, center) && Cast<AActor>(subject))
 		{
-			AActor* actor = result->GetItemAsActor(i);
-			if (!IsValid(actor))
-			{
-				continue;
-			}
+			center = Cast<AActor>(subject)->GetActorLocation();
+		}
+	}
+
+	TArray<UObject*> found;
+	grid->FindInRadius(center, targetingParams.radius, found);
+
+	for (UObject* entity : found)
+	{
+		UPurposeAbilityComponent* target = Cast<UPurposeAbilityComponent>(entity);
+		if (!target || target->GetAvatarActor() == source)
+		{
+			continue;
+		}
+
+		if (targetingParams.intent != EIntentTowardsGroup::None && (!IsValid(target->Manager()) || target->Manager()->GroupMembershipFor(inGoal.GetContextID()) == 0))
+		{
+			continue;/// Intent is towards a group, so the target must belong to one
+		}
+
+		if (targetingParams.groupRelationship != EGroupRelationship::None && !TargetHasGroupRelationship(target, inGoal, targetingParams.groupRelationship))
+		{
+			continue;
+		}
+
+		outDataMaps.Add(target);
+	}
+
+	Global::Log(DATADEBUG, OBJECTIVE, *this, "NativeObjectiveTargets", TEXT("Found %i targets of %i within %f of %s.")
+		, outDataMaps.Num()
+		, found.Num()
+		, targetingParams.radius
+		, *center.ToString()
+	);
+	return outDataMaps;
+}
+
+bool AManager::GatherSubjectsForSubPurposeSelection(const int PurposeLayerForUniqueSubjects, const FContextData& parentContext, TArrayView<const FPurposeTreeNode> subPurposes)
+{
+	if (PurposeLayerForUniqueSubjects != (int)EPurposeLayer::Objective || !IsValid(director) || !UEnvQueryManager::GetCurrent(GetWorld()))
+	{
+		return false;
+	}
+
+	const int32 batchID = nextObjectiveTargetBatch++;
+	FObjectiveTargetBatch& batch = objectiveTargetBatches.Add(batchID);
+	for (const FPurposeTreeNode& subPurpose : subPurposes)
+	{
+		const FObjectiveLayer* objective = director->FindObjectiveLayer(subPurpose.address);
+		if (objective && objective->targetingParams.targetingMethod == ETargetingMethod::Query && objective->targetingParams.targetingQuery)
+		{
+			batch.targetsOfQueries.FindOrAdd(objective->targetingParams.targetingQuery.Get());
+		}
+	}
+
+	if (batch.targetsOfQueries.Num() == 0)/// Nothing to wait on, so the sub purposes are queued immediately
+	{
+		objectiveTargetBatches.Remove(batchID);
+		return false;
+	}
 
-			Global::Log(DATATRIVIAL, OBJECTIVE, *this, "PotentialObjectiveTargets", TEXT("Hit Result: %s."), *actor->GetName());
+	batch.goalContextID = parentContext.GetContextID();
+	batch.goalAddress = parentContext.addressOfPurpose;
+	batch.pendingQueries = batch.targetsOfQueries.Num();
 
-			UPurposeAbilityComponent* purposeComp = actor->FindComponentByClass<UPurposeAbilityComponent>();
+	TArray<const UEnvQuery*> queries;
+	batch.targetsOfQueries.GetKeys(queries);
+	for (const UEnvQuery* query : queries)
+	{
+		TArray<TScriptInterface<IDataMapInterface>> cachedTargets;
+		if (targetQueryCache.Find(FTargetQueryKey(query, this, parentContext.GetContextID()), GetWorld()->GetTimeSeconds(), cachedTargets))
+		{
+			SetBatchTargets(batch, query, cachedTargets);
+			--batch.pendingQueries;/// Another Goal of the tree has already asked
+			continue;
+		}
 
-			if (!purposeComp) { purposeComp = actor->GetOwner()->FindComponentByClass<UPurposeAbilityComponent>(); }
-			else if (!purposeComp) { purposeComp = actor->IsA<APawn>() ? Cast<APawn>(actor)->GetController()->FindComponentByClass<UPurposeAbilityComponent>() : nullptr; }
-			else if (!purposeComp) { purposeComp = actor->GetOwner()->IsA<ALyraPlayerController>() ? Cast<ALyraPlayerController>(actor->GetOwner())->PlayerState->FindComponentByClass<UPurposeAbilityComponent>() : nullptr; }
+		FEnvQueryRequest QueryRequest(query, this);
+		if (QueryRequest.Execute(EEnvQueryRunMode::AllMatching, FQueryFinishedSignature::CreateUObject(this, &AManager::ObjectiveTargetsQueried, batchID, query)) == INDEX_NONE)
+		{
+			--batch.pendingQueries;/// Will never call back, its Objectives simply find no targets of their own
+		}
+	}
+
+	Global::Log(DATADEBUG, OBJECTIVE, *this, "GatherSubjectsForSubPurposeSelection", TEXT("Querying %i targeting queries for goal %s.")
+		, queries.Num()
+		, *parentContext.GetPurposeChainName()
+	);
+
+	if (batch.pendingQueries <= 0)
+	{
+		FinishObjectiveTargetBatch(batchID);
+	}
+	return true;
+}
+
+bool AManager::AssignSubPurposesJointly(const int PurposeLayerForUniqueSubjects, const FContextData& parentContext, TArrayView<const FPurposeTreeNode> subPurposes, FJointPotentialPurposes& outJointPurposes)
+{
+	if (!bAssignObjectivesJointly || PurposeLayerForUniqueSubjects != (int)EPurposeLayer::Objective || !IsValid(director))
+	{
+		return false;
+	}
+
+	for (const FPurposeTreeNode& subPurpose : subPurposes)
+	{
+		const FObjectiveLayer* objective = director->FindObjectiveLayer(subPurpose.address);
+		if (objective && objective->maxParticipants > 0)
+		{
+			outJointPurposes.capacityOfSubPurpose.Add(subPurpose.address.GetAddressOfThisPurpose(), FMath::Max(objective->maxParticipants - parentContext.SubPurposeParticipants(subPurpose.address), 0));
+		}
+	}
+
+	/// A candidate already taking part in an Objective of this Goal only gives up its place once it is assigned another
+	for (TObjectPtr<UPurposeAbilityComponent> candidate : ownedPurposeCandidates)
+	{
+		if (!IsValid(candidate) || !candidate->HasCurrentObjective())
+		{
+			continue;
+		}
+
+		const FContextData& currentObjective = candidate->CurrentObjective();
+		if (currentObjective.GetContextID() == parentContext.GetContextID() && currentObjective.addressOfPurpose.Truncate(parentContext.addressOfPurpose.GetAddressLayer()) == parentContext.addressOfPurpose)
+		{
+			outJointPurposes.heldSubPurposeOfCandidate.Add(candidate.Get(), currentObjective.addressOfPurpose.GetAddressOfThisPurpose());
+		}
+	}
+
+	return true;
+}
 
-			if (!purposeComp->IsValidLowLevel())
+void AManager::ObjectiveTargetsQueried(TSharedPtr<FEnvQueryResult> result, int32 batchID, const UEnvQuery* query)
+{
+	FObjectiveTargetBatch* batch = objectiveTargetBatches.Find(batchID);
+	if (!batch)
+	{
+		return;
+	}
+
+	if (result.IsValid() && result->IsSuccessful())
+	{
+		const TArray<TScriptInterface<IDataMapInterface>> targets = TargetsFromQueryResult(*result);
+		SetBatchTargets(*batch, query, targets);
+		targetQueryCache.Add(FTargetQueryKey(query, this, batch->goalContextID), GetWorld()->GetTimeSeconds(), targets);
+	}
+
+	if (--batch->pendingQueries <= 0)
+	{
+		FinishObjectiveTargetBatch(batchID);
+	}
+}
+
+void AManager::FinishObjectiveTargetBatch(const int32 batchID)
+{
+	FObjectiveTargetBatch batch;
+	if (!objectiveTargetBatches.RemoveAndCopyValue(batchID, batch))
+	{
+		return;
+	}
+
+	const FContextData* goal = GetStoredPurpose(batch.goalContextID, batch.goalAddress, (int)EPurposeLayer::Goal);
+	if (!goal)/// The Goal ended while its targets were being found
+	{
+		Global::Log(DATADEBUG, OBJECTIVE, *this, "FinishObjectiveTargetBatch", TEXT("Goal at %s is no longer tracked, discarding its targets."), *batch.goalAddress.GetAddressAsString());
+		return;
+	}
+
+	TMap<const UEnvQuery*, TArray<TScriptInterface<IDataMapInterface>>> targetsOfQueries;
+	for (const TPair<const UEnvQuery*, TArray<TWeakInterfacePtr<IDataMapInterface>>>& queryTargets : batch.targetsOfQueries)
+	{
+		TArray<TScriptInterface<IDataMapInterface>>& targets = targetsOfQueries.Add(queryTargets.Key);
+		for (const TWeakInterfacePtr<IDataMapInterface>& target : queryTargets.Value)
+		{
+			if (target.IsValid())
 			{
-				Global::Log(DATADEBUG, OBJECTIVE, *this, "PotentialObjectiveTargets", TEXT("Could not find purpose component of target: %s.")
-					, *actor->GetName()
-				);
-				continue;
+				targets.Add(target.ToScriptInterface());
 			}
-
-			outDataMaps.Add(purposeComp);
-			Global::Log(DATADEBUG, OBJECTIVE, *this, "PotentialObjectiveTargets", TEXT("Target: %s.")
-				, *purposeComp->GetName()
-			);
 		}
+	}
 
-		return outDataMaps;
+	TGuardValue<const TMap<const UEnvQuery*, TArray<TScriptInterface<IDataMapInterface>>>*> queueingBatch(targetsOfBatchBeingQueued, &targetsOfQueries);
+	PurposeSystem::QueueSubPurposesForCandidates(*goal);
+}
+
+void AManager::SetBatchTargets(FObjectiveTargetBatch& batch, const UEnvQuery* query, const TArray<TScriptInterface<IDataMapInterface>>& targets)
+{
+	TArray<TWeakInterfacePtr<IDataMapInterface>>& batchTargets = batch.targetsOfQueries.FindOrAdd(query);
+	batchTargets.Reset(targets.Num());
+	for (const TScriptInterface<IDataMapInterface>& target : targets)
+	{
+		batchTargets.Add(TWeakInterfacePtr<IDataMapInterface>(target.GetObject()));
 	}
-	else
+}
+
+TArray<TScriptInterface<IDataMapInterface>> AManager::TargetsFromQueryResult(const FEnvQueryResult& result)
+{
+	TArray<TScriptInterface<IDataMapInterface>> outDataMaps;
+	const FPurposeComponentRegistry* registry = GetPurposeComponentRegistry();
+	for (int i = 0; i < result.Items.Num(); ++i)
 	{
-		Global::LogError(OBJECTIVE, *this, "PotentialObjectiveTargets", TEXT("Source or World are nullptr!"));
+		AActor* actor = result.GetItemAsActor(i);
+		if (!IsValid(actor))
+		{
+			continue;
+		}
+
+		Global::Log(DATATRIVIAL, OBJECTIVE, *this, "TargetsFromQueryResult", TEXT("Hit Result: %s."), *actor->GetName());
+
+		UPurposeAbilityComponent* purposeComp = registry ? registry->Find(actor) : nullptr;/// The actor may be the owner, avatar, controller or player state of the component
+
+		if (!purposeComp)/// Not registered, such as a component which has not yet joined the purpose system, so search the related actors
+		{
+			purposeComp = actor->FindComponentByClass<UPurposeAbilityComponent>();
+		}
+		if (!purposeComp && actor->GetOwner())
+		{
+			purposeComp = actor->GetOwner()->FindComponentByClass<UPurposeAbilityComponent>();
+		}
+		APawn* pawn = Cast<APawn>(actor);
+		if (!purposeComp && pawn && pawn->GetController())
+		{
+			purposeComp = pawn->GetController()->FindComponentByClass<UPurposeAbilityComponent>();
+		}
+		if (!purposeComp && pawn && pawn->GetPlayerState())
+		{
+			purposeComp = pawn->GetPlayerState()->FindComponentByClass<UPurposeAbilityComponent>();
+		}
+
+		if (!purposeComp)
+		{
+			Global::Log(DATADEBUG, OBJECTIVE, *this, "TargetsFromQueryResult", TEXT("Could not find purpose component of target: %s.")
+				, *actor->GetName()
+			);
+			continue;
+		}
+
+		outDataMaps.Add(purposeComp);
+		Global::Log(DATADEBUG, OBJECTIVE, *this, "TargetsFromQueryResult", TEXT("Target: %s.")
+			, *purposeComp->GetName()
+		);
 	}
 
-	return TArray< TScriptInterface<IDataMapInterface> >();
+	return outDataMaps;
 }
 
 bool AManager::TargetHasGroupRelationship(TObjectPtr<UPurposeAbilityComponent> target, const FContextData& inGoal, EGroupRelationship groupRelationship)
 {
 	bool result = false;
 
-	if (groupRelationship != EGroupRelationship::None && IsValid(target))
+	if (groupRelationship != EGroupRelationship::None && IsValid(target) && IsValid(target->Manager()))
 	{
-		FContextData& eventContext = GetStoredPurpose(inGoal.GetContextID(), inGoal.addressOfPurpose, (int)EPurposeLayer::Event);
-		FEventLayer eventLayer;
-		
-		if (!IsValid(director))
+		const uint16 targetGroups = target->Manager()->GroupMembershipFor(inGoal.GetContextID());/// Which groups of this Event the target belongs to, if any
+		if (targetGroups == 0 || !IsValid(director))
 		{
 			return false;
 		}
 
-		if (!director->GetEventLayer(inGoal.addressOfPurpose, eventLayer))
+		const FEventLayer* eventLayer = director->FindEventLayer(inGoal.addressOfPurpose);
+		if (!eventLayer)
 		{
 			return false;
 		}
 
-		EEventGroup sourceGroup = eventLayer.GroupingForGoal(inGoal.addressOfPurpose);/// By establishing the source group of the Event
-		
-		////Global::Log(Debug, PurposeLog, *this, "TargetHasGroupRelationship", TEXT("Event: %s. Number of targetManager->Goals: %d"), *Event->GetName(), target->Manager()->DataChunk<UTrackedPurposes>()->Value().Num());
-		for (auto goal : target->Manager()->DataChunk<UTrackedPurposes>()->Value())
+		EEventGroup sourceGroup = eventLayer->GroupingForGoal(inGoal.addressOfPurpose);/// By establishing the source group of the Event
+		if (sourceGroup == EEventGroup::None)
 		{
-			////Global::Log(Debug, PurposeLog, *this, "TargetHasGroupRelationship", TEXT("Goal: %s."), *goal->GetName());
+			return false;
+		}
 
-			EEventGroup targetGroup = eventLayer.GroupingForGoal(goal.addressOfPurpose);/// Then finding which group the target belongs to, if any
-			if (targetGroup != EEventGroup::None)
-			{
-				if (targetGroup == sourceGroup && groupRelationship == EGroupRelationship::Allies) { return true; }/// If the actors belong to the same Goal they are allies
+		if (groupRelationship == EGroupRelationship::Allies && (targetGroups & (1 << (int32)sourceGroup))) { return true; }/// If the actors belong to the same Goal they are allies
 
-				EGroupRelationship relation = eventLayer.RelationshipBetweenGroups(sourceGroup, targetGroup);/// We can determine the relationship between the groups
+		for (int32 targetGroup = 0; targetGroup < FEventLayer::NumGroups; ++targetGroup)
+		{
+			if (targetGroups & (1 << targetGroup))
+			{
+				EGroupRelationship relation = eventLayer->RelationshipBetweenGroups(sourceGroup, StaticCast<EEventGroup>(targetGroup));/// We can determine the relationship between the groups
 				result = relation == groupRelationship;/// And whether it matches the input relationship
 			}
 
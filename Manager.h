@@ -10,8 +10,30 @@
 #include "Purpose/PurposeAbilityComponent.h"
 #include "Engine/DeveloperSettings.h"
 #include "Purpose/PurposeEvaluationThread.h"
+#include "Purpose/PurposeReplicatedDataMap.h"
+#include "Purpose/PurposeTrackedPurposeStore.h"
+#include "Purpose/PurposeTargetQueryCache.h"
 #include "Manager.generated.h"
 
+struct FEnvQueryResult;
+
+/// The Objectives of a single Goal context whose targeting queries are running
+/// Sub purposes of the Goal are only queued for its candidates once every query has returned
+/// Held outside of any UPROPERTY, so it keeps neither the Goal nor the targets, only what finds them again
+struct FObjectiveTargetBatch
+{
+	/// The Goal whose Objectives are being targeted, looked up once the batch finishes so its sub purposes are queued with its current participation
+	int64 goalContextID = 0;
+	FPurposeAddress goalAddress;
+
+	/// Queries yet to return
+	int32 pendingQueries = 0;
+
+	/// As the manager is always the querier, each query is run once for the Goal and its results handed to every candidate
+	/// Targets destroyed while the other queries run are dropped as the batch finishes
+	TMap<const class UEnvQuery*, TArray<TWeakInterfacePtr<IDataMapInterface>>> targetsOfQueries;
+};
+
 ///The Manager class is the foundation of all actor gameplay. They manage all spawning, controlling, and requests of AI or Players.
 ///This allows us to establish a floodgate for logic, so all debugging of gameplay can be traced through that channel.
 UCLASS(NotPlaceable)
@@ -29,6 +51,11 @@ protected:
 
 	virtual void BeginDestroy() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/// Syncs the replicated data map with any changes to data since the last net update
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
 
 	UPROPERTY(Replicated)
 	///This map is the link between a managed actor and their character data
@@ -49,6 +76,21 @@ public:
 
 	TArray<FPurposeEvaluationThread*> GetBackgroundPurposeThreads() final;
 
+	FPurposeBlackboard* GetWorldStateBlackboard() final;
+
+	FDataChunkPool* GetDataChunkPool() final { return &dataChunkPool; }
+
+	FPurposeContextStore* GetContextStore() final;
+
+	FContextTreeRegistry* GetContextTreeRegistry() final;
+
+	FPurposeSpatialGrid* GetSpatialGrid() final;
+
+	FPurposeComponentRegistry* GetPurposeComponentRegistry() final;
+
+	uint32 DataMapVersion() const final { return dataMapVersion; }
+	void IncrementDataMapVersion() final { ++dataMapVersion; }
+
 	TArray<TScriptInterface<IDataMapInterface>> GetCandidatesForSubPurposeSelection(const int PurposeLayerForUniqueSubjects) final;
 
 	/// @param PurposeLayerForUniqueSubjects: Represents the purpose layer for which the PurposeOwner is meant to create new FUniqueSubjectMaps
@@ -57,22 +99,31 @@ public:
 	/// @return TArray<FSubjectMap>: Each entry is a combination of the candidate and whatever other subjects required for the subpurpose indicated by addressOfSubPurpose
 	virtual TArray<FSubjectMap> GetUniqueSubjectsRequiredForSubPurposeSelection(const int PurposeLayerForUniqueSubjects, const FContextData& parentContext, TScriptInterface<IDataMapInterface> candidate, FPurposeAddress addressOfSubPurpose) override;
 
+	/// Runs the targeting query of each Objective beneath the Goal through the EQS manager's time sliced queue, rather than once per candidate within the game thread
+	/// @return bool: True if queries were started, the Goal's sub purposes then being queued by ObjectiveTargetsQueried
+	bool GatherSubjectsForSubPurposeSelection(const int PurposeLayerForUniqueSubjects, const FContextData& parentContext, TArrayView<const FPurposeTreeNode> subPurposes) final;
+
+	/// When bAssignObjectivesJointly, the Objectives of a Goal are shared out between every candidate at once, each Objective limited to its FObjectiveLayer::maxParticipants
+	bool AssignSubPurposesJointly(const int PurposeLayerForUniqueSubjects, const FContextData& parentContext, TArrayView<const FPurposeTreeNode> subPurposes, FJointPotentialPurposes& outJointPurposes) final;
+
 	bool ProvidePurposeToOwner(const FContextData& purposeToStore) final;
 
 	/// Events must be stored globally for the duration of a game so that they may have a consistent PurposeAddress
-	TArray<FPurpose> GetEventAssets() final;
-
-	/// As FPurpose can not hold an variable or TArray<> of itself, we're forced to workaround simply accessing subpurposes
-	TArray<FPurpose> GetSubPurposesFor(FPurposeAddress address) final;
+	FCompiledPurposeTreePtr GetPurposeTree() final;
 
 	/// When a purpose is put up for selection, but it appears to be a duplicate of a current purpose, we want to let the purpose owner handle the reoccurrence
 	void PurposeReOccurrence(const FPurposeAddress addressOfPurpose, const int64 uniqueIDofActivePurpose) final;
 
+	/// Completion is only checked for Objectives, by their candidates
+	void CompletionEvaluated(const int64 uniqueContextID, const FPurposeAddress& addressOfPurpose, const EPurposeState status) final {}
+
 	/// @param uniqueIdentifierOfContextTree: This ID unique to a series of context datas starting with Event allows separation of same purposes for different contexts
 	/// @param fullAddress: Tying the address to the unique ID is how we can search stored contexts for the relevant context we seek
 	/// @param layerToRetrieveFor: We may not necessarily wish to find the end address of the fullAddress, so we can indicate a layer to seek out
-	/// @return FContextData&: Need to check for validity as the context data may not have been found and an empty struct returned
-	FContextData& GetStoredPurpose(const int64 uniqueIdentifierOfContextTree, const FPurposeAddress& fullAddress, const int layerToRetrieveFor) final;
+	/// @return FContextData*: The stored context itself, nullptr if it was not found
+	FContextData* GetStoredPurpose(const int64 uniqueIdentifierOfContextTree, const FPurposeAddress& fullAddress, const int layerToRetrieveFor) final;
+
+	void StoredPurposeChanged(const FContextData& storedContext) final;
 
 	/// @param parentAddress: An address which is either that of a purpose containing behaviors so that it may reference the parent, or the parent address itself
 	/// @param TArray<TObjectPtr<UGA_Behavior>>: All the behaviors contained by the parent indicated
@@ -83,10 +134,11 @@ public:
 	TObjectPtr<class UBehavior_AI> GetBehaviorAtAddress(const FPurposeAddress& inAddress) final { return GetHeadOfPurposeManagment()->GetBehaviorAtAddress(inAddress); }
 
 	///@return bool: Always false, as managers only receive Goals, which aren't an executable behavior, but rather just a filter
-	bool DoesPurposeAlreadyExist(const FContextData& primary, const FSubjectMap& secondarySubjects, const TArray<FDataMapEntry>& secondaryContext, const FPurposeAddress optionalAddress = FPurposeAddress()) final { return false; }
+	bool DoesPurposeAlreadyExist(const FContextData& primary, const FSubjectMap& secondarySubjects, const TArray<FDataMapEntry>& secondaryContext, const FInlineDataMap& secondaryValues, const FPurposeAddress optionalAddress = FPurposeAddress()) final { return false; }
 
 	/// Managers will require access to the director in order to further purpose evaluation
-	void EstablishAccessToPurposeThreads(TObjectPtr<class ADirector_Level> inDirector) { director = inDirector; }
+	/// Also registers the manager with the director's world state blackboard
+	void EstablishAccessToPurposeThreads(TObjectPtr<class ADirector_Level> inDirector);
 
 	void ReevaluateObjectivesForAllCandidates(const FPurposeAddress& addressOfGoal, const int64& uniqueIDofActivePurpose);
 
@@ -113,8 +165,15 @@ public:
 		, const FContextData& inGoal
 		, FTargetingParameters targetingParams
 	);
+	/// Finds targets through the director's FPurposeSpatialGrid rather than an EQS query, see ETargetingMethod::Native
+	/// @param source: The candidate's avatar, the center of targeting when targetingParams.targetLocation is not found
+	TArray<TScriptInterface<IDataMapInterface>> NativeObjectiveTargets(
+		TObjectPtr<AActor> source
+		, const FContextData& inGoal
+		, const FTargetingParameters& targetingParams
+	);
 	/// By finding the Event of the inGoal, we establish which group the inGoal belongs to
-	/// Then checking whether any of the Goals held by the target->Manager() belong to the Event
+	/// Then checking which groups of the same Event context the target->Manager() belongs to
 	/// We can establish if the relationship between inGoal and target->Manager()->eventGoal is the requested relationship
 	/// @param source: actor we wish to utilize as source of targeting
 	/// @param inGoal: Provides a source to determine group relationships relative to Parent Event
@@ -125,6 +184,17 @@ public:
 		, EGroupRelationship groupRelationship
 	);
 
+	/// The Goals this manager has been provided
+	const FTrackedPurposeStore& TrackedPurposes() const { return trackedPurposes; }
+
+	/// @param uniqueContextID: The context ID shared by an Event and its Goals
+	/// @return uint16: One bit per EEventGroup this manager holds a Goal for within the Event context, 0 if none
+	uint16 GroupMembershipFor(const int64 uniqueContextID) const
+	{
+		const uint16* groups = groupMembership.Find(uniqueContextID);
+		return groups ? *groups : 0;
+	}
+
 
 protected:
 
@@ -148,18 +218,71 @@ protected:
 
    float timeBetweenEQSQueries = 0.25f;
 
+   /// Rather than each candidate selecting its own best Objective, candidates are assigned Objectives together so they don't all pile onto the same one
+   UPROPERTY(EditAnywhere)
+   bool bAssignObjectivesJointly = false;
+
    TWeakObjectPtr<class UEnvQuery> playerSightEQSCache = nullptr;
 
 private:
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	///This data is representative of the subject "ESubject::Candidate"
+	/// Replicated through replicatedData, so that only changed entries are sent
 	TArray<FDataMapEntry> data;
 
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedData)
+	FReplicatedDataMap replicatedData;
+
+	UPROPERTY()
+	/// Chunks created within our data map by data adjustments, recycled as they are removed or replaced
+	FDataChunkPool dataChunkPool;
+
+	UFUNCTION()
+	void OnRep_ReplicatedData();
+
 	/// Force implementers to provide an editable datamap
 	/// The only way to the change the DataMap is through the Server RPCs
+	/// Free of side effects, as lookups pass through here too, the data map version is raised by AddData, AppendData and RemoveData instead
 	TArray<FDataMapEntry>& DataMapInternal() final { return data; }
 
+	/// Raised whenever the data map may have changed, allowing the blackboard to reuse its last copy until it does
+	uint32 dataMapVersion = 0;
+
+	/// Every Goal provided to this manager, until the Event it belongs to ends
+	/// GetStoredPurpose hands out pointers into it, so it must not be copied
+	/// Mirrored into our UTrackedPurposes chunk from BeginPlay
+	FTrackedPurposeStore trackedPurposes;
+
+	/// The groups held per Event context, kept alongside trackedPurposes by ProvidePurposeToOwner and EndGoalsOfEvent
+	/// Allows TargetHasGroupRelationship to avoid walking the target's tracked Goals
+	TMap<int64, uint16> groupMembership;
+
+	/// Seconds the targets of a query are reused beyond the frame they were found in, applied to targetQueryCache at BeginPlay
+	UPROPERTY(EditAnywhere)
+	float targetQueryCacheLifetime = 0.25f;
+
+	/// Targets of each query this manager has run per context tree, shared by every candidate and Objective asking the same query
+	FTargetQueryCache targetQueryCache;
+
+	/// Objective targeting batches awaiting their queries, by batch ID
+	TMap<int32, FObjectiveTargetBatch> objectiveTargetBatches;
+
+	int32 nextObjectiveTargetBatch = 0;
+
+	/// Set while a completed batch queues its sub purposes, so PotentialObjectiveTargets takes the targets already found
+	const TMap<const class UEnvQuery*, TArray<TScriptInterface<IDataMapInterface>>>* targetsOfBatchBeingQueued = nullptr;
+
+	/// Bound to each query of a batch, queuing the Goal's sub purposes once the last has returned
+	void ObjectiveTargetsQueried(TSharedPtr<FEnvQueryResult> result, int32 batchID, const class UEnvQuery* query);
+
+	void FinishObjectiveTargetBatch(const int32 batchID);
+
+	void SetBatchTargets(FObjectiveTargetBatch& batch, const class UEnvQuery* query, const TArray<TScriptInterface<IDataMapInterface>>& targets);
+
+	/// @return TArray<TScriptInterface<IDataMapInterface>>: The purpose components of every actor found by the query
+	TArray<TScriptInterface<IDataMapInterface>> TargetsFromQueryResult(const FEnvQueryResult& result);
+
 	/// Virtual so that individual manager types can determine when an actor should be ignored for an Objective selection
 	virtual bool IgnoreActorForObjective(TObjectPtr<UPurposeAbilityComponent> actor, TObjectPtr<UContextData_Deprecated> inContext) { return false; }
 
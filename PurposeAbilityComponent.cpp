@@ -26,6 +26,10 @@
 #include "Purpose/Abilities/GA_PurposeBase.h"
 #include "Purpose/Assets/EventAsset.h"
 #include "Purpose/DataChunks/ActorAction.h"
+#include "Purpose/PurposeTrackedPurposeStore.h"
+#include "Purpose/PurposeSpatialGrid.h"
+#include "Purpose/PurposeComponentRegistry.h"
+#include "GameFramework/PlayerState.h"
 
 UPurposeAbilityComponent::UPurposeAbilityComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -36,16 +40,232 @@ UPurposeAbilityComponent::UPurposeAbilityComponent(const FObjectInitializer& Obj
 void UPurposeAbilityComponent::InitializePurposeSystem(TObjectPtr<AManager> inManager)
 {
 	manager = inManager;
+	dataChunkPool.Initialize(this);
 
 	AbilityActivatedCallbacks.AddUObject(this, &UPurposeAbilityComponent::ActionPerformed);/// Primarily set up since player input goes straight to the ability system
 	/// But now all behavior occurrences are routed through BehaviorPerformed
+
+	if (FPurposeBlackboard* blackboard = GetWorldStateBlackboard())
+	{
+		blackboard->RegisterEntity(this);/// So that background threads may read our data as a subject without copying it per request
+	}
+
+	RegisterStandInActors();
+
+	/// Possession changes which pawn and controller stand for us
+	if (APawn* pawn = Cast<APawn>(GetOwner()))
+	{
+		pawn->ReceiveControllerChangedDelegate.AddUniqueDynamic(this, &UPurposeAbilityComponent::ControllerChanged);
+	}
+	else if (APlayerState* playerState = Cast<APlayerState>(GetOwner()))
+	{
+		playerState->OnPawnSet.AddUniqueDynamic(this, &UPurposeAbilityComponent::PlayerStatePawnSet);
+	}
+	else if (AController* controller = Cast<AController>(GetOwner()))
+	{
+		controller->OnPossessedPawnChanged.AddUniqueDynamic(this, &UPurposeAbilityComponent::PossessedPawnChanged);
+	}
+
+	BindAvatar();/// So native targeting may find us without an EQS query
+}
+
+void UPurposeAbilityComponent::InitAbilityActorInfo(AActor* InOwnerActor, AActor* InAvatarActor)
+{
+	Super::InitAbilityActorInfo(InOwnerActor, InAvatarActor);
+
+	StandInActorsChanged();
+}
+
+void UPurposeAbilityComponent::BindAvatar()
+{
+	FPurposeSpatialGrid* grid = GetSpatialGrid();
+	AActor* avatar = GetAvatarActor();
+	USceneComponent* avatarRoot = IsValid(avatar) ? avatar->GetRootComponent() : nullptr;
+
+	if (movingAvatarRoot.Get() != avatarRoot)
+	{
+		if (movingAvatarRoot.IsValid())
+		{
+			movingAvatarRoot->TransformUpdated.Remove(avatarMovedHandle);
+		}
+		movingAvatarRoot = avatarRoot;
+		avatarMovedHandle = avatarRoot && grid ? avatarRoot->TransformUpdated.AddUObject(this, &UPurposeAbilityComponent::AvatarMoved) : FDelegateHandle();
+	}
+
+	if (grid)
+	{
+		if (avatarRoot)
+		{
+			grid->Add(this, avatarRoot->GetComponentLocation());/// Moves us should we already be in the grid
+		}
+		else
+		{
+			grid->Remove(this);
+		}
+	}
+}
+
+void UPurposeAbilityComponent::RegisterStandInActors()
+{
+	if (FPurposeComponentRegistry* registry = GetPurposeComponentRegistry())
+	{
+		/// Targeting may find any of the actors standing for us, so each is resolved back to us
+		TArray<AActor*, TInlineAllocator<4>> actors;
+		actors.Add(GetOwner());
+		actors.Add(GetAvatarActor());
+		if (APlayerState* playerState = Cast<APlayerState>(GetOwner()))
+		{
+			actors.Add(playerState->GetOwningController());
+			actors.Add(playerState->GetPawn());
+		}
+		else if (APawn* pawn = Cast<APawn>(GetOwner()))
+		{
+			actors.Add(pawn->GetController());
+			actors.Add(pawn->GetPlayerState());
+		}
+		else if (AController* controller = Cast<AController>(GetOwner()))
+		{
+			actors.Add(controller->GetPawn());
+			actors.Add(controller->PlayerState);
+		}
+		registry->Register(this, actors);
+	}
+}
+
+void UPurposeAbilityComponent::StandInActorsChanged()
+{
+	if (IsValid(manager))
+	{
+		RegisterStandInActors();
+		BindAvatar();
+	}
+}
+
+void UPurposeAbilityComponent::PossessedPawnChanged(APawn* oldPawn, APawn* newPawn)
+{
+	StandInActorsChanged();
+}
+
+void UPurposeAbilityComponent::ControllerChanged(APawn* pawn, AController* oldController, AController* newController)
+{
+	StandInActorsChanged();
+}
+
+void UPurposeAbilityComponent::PlayerStatePawnSet(APlayerState* playerState, APawn* newPawn, APawn* oldPawn)
+{
+	StandInActorsChanged();
+}
+
+void UPurposeAbilityComponent::AvatarMoved(USceneComponent* movedComponent, EUpdateTransformFlags updateTransformFlags, ETeleportType teleport)
+{
+	if (FPurposeSpatialGrid* grid = IsValid(manager) ? GetSpatialGrid() : nullptr)
+	{
+		grid->Move(this, movedComponent->GetComponentLocation());
+	}
+}
+
+void UPurposeAbilityComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (IsValid(manager))
+	{
+		if (FPurposeBlackboard* blackboard = GetWorldStateBlackboard())
+		{
+			blackboard->UnregisterEntity(this);
+		}
+
+		if (FPurposeSpatialGrid* grid = GetSpatialGrid())
+		{
+			grid->Remove(this);
+		}
+
+		if (FPurposeComponentRegistry* registry = GetPurposeComponentRegistry())
+		{
+			registry->Unregister(this);
+		}
+
+		if (FPurposeContextStore* store = GetContextStore())
+		{
+			store->Release(currentObjective);
+			currentObjective = FContextHandle();
+		}
+	}
+
+	if (movingAvatarRoot.IsValid())
+	{
+		movingAvatarRoot->TransformUpdated.Remove(avatarMovedHandle);
+	}
+	movingAvatarRoot = nullptr;
+
+	if (APawn* pawn = Cast<APawn>(GetOwner()))
+	{
+		pawn->ReceiveControllerChangedDelegate.RemoveDynamic(this, &UPurposeAbilityComponent::ControllerChanged);
+	}
+	else if (APlayerState* playerState = Cast<APlayerState>(GetOwner()))
+	{
+		playerState->OnPawnSet.RemoveDynamic(this, &UPurposeAbilityComponent::PlayerStatePawnSet);
+	}
+	else if (AController* controller = Cast<AController>(GetOwner()))
+	{
+		controller->OnPossessedPawnChanged.RemoveDynamic(this, &UPurposeAbilityComponent::PossessedPawnChanged);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UPurposeAbilityComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	/// Here we list the variables we want to replicate + a condition if wanted
-	DOREPLIFETIME(UPurposeAbilityComponent, data);
+	DOREPLIFETIME(UPurposeAbilityComponent, replicatedData);
+}
+
+void UPurposeAbilityComponent::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	replicatedData.SyncFrom(data, dataMapVersion);
+}
+
+void UPurposeAbilityComponent::OnRep_ReplicatedData()
+{
+	replicatedData.CopyTo(DataMapInternal());
+	IncrementDataMapVersion();
+}
+
+void UPurposeAbilityComponent::AddData(UDataChunk* inData, bool overwriteValue)
+{
+	UDataChunk* replaced = IsValid(inData) && HasData(inData->GetClass()) ? DataChunk(inData->GetClass()) : nullptr;
+	IDataMapInterface::AddData(inData, overwriteValue);
+	IncrementDataMapVersion();
+	ReleaseDataChunk(replaced);/// Does nothing unless the chunk was actually replaced
+}
+
+void UPurposeAbilityComponent::AppendData(const TArray<FDataMapEntry>& inDataMap, bool overwriteValue)
+{
+	TArray<UDataChunk*> replaced;
+	for (const FDataMapEntry& entry : inDataMap)
+	{
+		if (IsValid(entry.Chunk) && HasData(entry.Chunk->GetClass()))
+		{
+			replaced.Add(DataChunk(entry.Chunk->GetClass()));
+		}
+	}
+
+	IDataMapInterface::AppendData(inDataMap, overwriteValue);
+	IncrementDataMapVersion();
+
+	for (UDataChunk* chunk : replaced)
+	{
+		ReleaseDataChunk(chunk);
+	}
+}
+
+void UPurposeAbilityComponent::RemoveData(TSubclassOf<UDataChunk> inClass)
+{
+	UDataChunk* removed = HasData(inClass) ? DataChunk(inClass) : nullptr;
+	IDataMapInterface::RemoveData(inClass);
+	IncrementDataMapVersion();
+	ReleaseDataChunk(removed);
 }
 
 void UPurposeAbilityComponent::PerformAbility(const FContextData& inContext, TSubclassOf<UGA_PurposeBase> abilityClass)
@@ -285,6 +505,57 @@ TArray<FPurposeEvaluationThread*> UPurposeAbilityComponent::GetBackgroundPurpose
 	return GetHeadOfPurposeManagment()->GetBackgroundPurposeThreads();
 }
 
+FPurposeBlackboard* UPurposeAbilityComponent::GetWorldStateBlackboard()
+{
+	return GetHeadOfPurposeManagment()->GetWorldStateBlackboard();
+}
+
+FPurposeContextStore* UPurposeAbilityComponent::GetContextStore()
+{
+	return GetHeadOfPurposeManagment()->GetContextStore();
+}
+
+FContextTreeRegistry* UPurposeAbilityComponent::GetContextTreeRegistry()
+{
+	return GetHeadOfPurposeManagment()->GetContextTreeRegistry();
+}
+
+FPurposeSpatialGrid* UPurposeAbilityComponent::GetSpatialGrid()
+{
+	return GetHeadOfPurposeManagment()->GetSpatialGrid();
+}
+
+FPurposeComponentRegistry* UPurposeAbilityComponent::GetPurposeComponentRegistry()
+{
+	return GetHeadOfPurposeManagment()->GetPurposeComponentRegistry();
+}
+
+const FContextData& UPurposeAbilityComponent::CurrentObjective()
+{
+	FPurposeContextStore* store = currentObjective.IsSet() && IsValid(manager) ? GetContextStore() : nullptr;
+	const FContextData* context = store ? store->Get(currentObjective) : nullptr;
+	return context ? *context : FTrackedPurposeStore::InvalidContext();
+}
+
+void UPurposeAbilityComponent::SetCurrentObjective(FContextData inContext)
+{
+	if (!IsValid(manager))
+	{
+		Global::LogError(OBJECTIVE, *this, "SetCurrentObjective", TEXT("Manager invalid, %s will not be held!"), *inContext.GetPurposeChainName());
+		return;
+	}
+
+	FPurposeContextStore* store = GetContextStore();
+	if (!store)
+	{
+		Global::LogError(OBJECTIVE, *this, "SetCurrentObjective", TEXT("No context store to hold %s!"), *inContext.GetPurposeChainName());
+		return;
+	}
+
+	store->Release(currentObjective);
+	currentObjective = inContext.ContextIsValid() ? store->Add(MoveTemp(inContext)) : FContextHandle();
+}
+
 TArray<TScriptInterface<IDataMapInterface>> UPurposeAbilityComponent::GetCandidatesForSubPurposeSelection(const int PurposeLayerForUniqueSubjects)
 {
 	TArray<TScriptInterface<IDataMapInterface>> candidates;
@@ -336,7 +607,7 @@ bool UPurposeAbilityComponent::ProvidePurposeToOwner(const FContextData& purpose
 	switch (purposeToStore.addressOfPurpose.GetAddressLayer())
 	{
 		case (int)EPurposeLayer::Objective:
-			if (CurrentObjective().ContextIsValid())
+			if (CurrentObjective().ContextIsValid() && !purposeToStore.bAssignedJointly)/// A joint assignment has already taken our place elsewhere, so it is never refused
 			{
 				if (CurrentObjective().cachedScoreOfPurpose >= purposeToStore.cachedScoreOfPurpose)/// Workaround for required data causing score to be 0 for the candidate who is already performing an Objective
 				{
@@ -379,36 +650,41 @@ bool UPurposeAbilityComponent::ProvidePurposeToOwner(const FContextData& purpose
 	}
 }
 
-TArray<FPurpose> UPurposeAbilityComponent::GetEventAssets()
+FCompiledPurposeTreePtr UPurposeAbilityComponent::GetPurposeTree()
 {
-	return GetHeadOfPurposeManagment()->GetEventAssets();
-}
-
-TArray<FPurpose> UPurposeAbilityComponent::GetSubPurposesFor(FPurposeAddress address)
-{
-	return GetHeadOfPurposeManagment()->GetSubPurposesFor(address);
+	return GetHeadOfPurposeManagment()->GetPurposeTree();
 }
 
 void UPurposeAbilityComponent::PurposeReOccurrence(const FPurposeAddress addressOfPurpose, const int64 uniqueIDofActivePurpose)
 {
 }
 
-FContextData& UPurposeAbilityComponent::GetStoredPurpose(const int64 uniqueIdentifierOfContextTree, const FPurposeAddress& fullAddress, const int layerToRetrieveFor)
+FContextData* UPurposeAbilityComponent::GetStoredPurpose(const int64 uniqueIdentifierOfContextTree, const FPurposeAddress& fullAddress, const int layerToRetrieveFor)
 {
 	switch (layerToRetrieveFor)
 	{
 		case (int)EPurposeLayer::Objective:
 
-			if (CurrentObjective().ContextIsValid() && CurrentObjective().GetContextID() == uniqueIdentifierOfContextTree && CurrentObjective().addressOfPurpose.GetAddressForLayer(layerToRetrieveFor) == fullAddress.GetAddressForLayer(layerToRetrieveFor))
+			FContextData* objective = currentObjective.IsSet() && IsValid(manager) ? GetContextStore()->Get(currentObjective) : nullptr;
+			if (objective && objective->GetContextID() == uniqueIdentifierOfContextTree && objective->addressOfPurpose.GetAddressForLayer(layerToRetrieveFor) == fullAddress.GetAddressForLayer(layerToRetrieveFor))
 			{
-				return CurrentObjective();
+				return objective;
 			}
 			break;
 	}
 	return GetPurposeSuperior()->GetStoredPurpose(uniqueIdentifierOfContextTree, fullAddress, layerToRetrieveFor);
 }
 
-bool UPurposeAbilityComponent::DoesPurposeAlreadyExist(const FContextData& primary, const FSubjectMap& secondarySubjects, const TArray<FDataMapEntry>& secondaryContext, const FPurposeAddress optionalAddress)
+void UPurposeAbilityComponent::StoredPurposeChanged(const FContextData& storedContext)
+{
+	/// The Objective is held by the context store, which publishes no copy of it
+	if (storedContext.addressOfPurpose.GetAddressLayer() - 1 != (int)EPurposeLayer::Objective)
+	{
+		GetPurposeSuperior()->StoredPurposeChanged(storedContext);
+	}
+}
+
+bool UPurposeAbilityComponent::DoesPurposeAlreadyExist(const FContextData& primary, const FSubjectMap& secondarySubjects, const TArray<FDataMapEntry>& secondaryContext, const FInlineDataMap& secondaryValues, const FPurposeAddress optionalAddress)
 {
 	return primary.Subject(ESubject::Candidate) == (secondarySubjects.subjects.Contains(ESubject::Candidate) ? secondarySubjects.subjects[ESubject::Candidate].GetObject() : nullptr)
 		&& primary.Subject(ESubject::ObjectiveTarget) == (secondarySubjects.subjects.Contains(ESubject::ObjectiveTarget) ? secondarySubjects.subjects[ESubject::ObjectiveTarget].GetObject() : nullptr)
@@ -437,19 +713,19 @@ void UPurposeAbilityComponent::EndCurrentObjective()
 	);
 
 	/// Crucial that on finished data adjustment is made if needed
-	CurrentObjective().AdjustDataIfPossible(CurrentObjective().purpose.DataAdjustments(), EPurposeSelectionEvent::OnFinished, OBJECTIVE, "EndObjective", this);
+	CurrentObjective().AdjustDataIfPossible(CurrentObjective().Purpose().DataAdjustments(), EPurposeSelectionEvent::OnFinished, OBJECTIVE, "EndObjective", this);
 
 	/// Decrease the address layer of the CurrentObjective in order to retrieve the Goal layer
-	FContextData& parentContext = CurrentObjective().purposeOwner->GetStoredPurpose(CurrentObjective().GetContextID(), CurrentObjective().addressOfPurpose, CurrentObjective().addressOfPurpose.GetAddressLayer() - 1);
-	if (parentContext.ContextIsValid())
+	if (FContextData* parentContext = CurrentObjective().purposeOwner->GetStoredPurpose(CurrentObjective().GetContextID(), CurrentObjective().addressOfPurpose, CurrentObjective().addressOfPurpose.GetAddressLayer() - 1))
 	{
 		/// As the Objective is finished, ensure participation is updated
-		if (!parentContext.DecreaseSubPurposeParticipants(CurrentObjective().addressOfPurpose))
+		if (!parentContext->DecreaseSubPurposeParticipants(CurrentObjective().addressOfPurpose))
 		{
 			Global::Log(DATADEBUG, PURPOSE, "PurposeSystem", "PurposeSelected", TEXT("Participation of %s not decreased!")
 				, *CurrentObjective().GetPurposeChainName()
 			);
 		}
+		CurrentObjective().purposeOwner->StoredPurposeChanged(*parentContext);
 	}
 
 	/// tthis could be solved by going through the management intterface
@@ -482,19 +758,21 @@ void UPurposeAbilityComponent::ActionPerformed(UGameplayAbility* Ability)
 
 		FSubjectMap subjectMap;
 		TArray<FDataMapEntry> contextData;
+		FInlineDataMap contextValues;
 
 		if (Ability->IsA<UGA_PurposeBase>())
 		{
 			subjectMap = Cast<UGA_PurposeBase>(Ability)->context.subjectMap;
 			contextData = Cast<UGA_PurposeBase>(Ability)->context.contextData;
+			contextValues = Cast<UGA_PurposeBase>(Ability)->context.contextValues;
 		}
 		else
 		{
 			subjectMap.subjects.Add(ESubject::Instigator, this);
-			contextData.Add(FDataMapEntry(&NewObject<UActorAction>(this)->Initialize(Ability->GetClass())));
+			contextValues.SetValue(FDataValue(UActorAction::StaticClass(), Ability->GetClass()));/// Read by conditions through FPurposeEvaluationThread::ContextValue, so no chunk is created per action
 		}
 
-		PurposeSystem::Occurrence(subjectMap, contextData, this);
+		PurposeSystem::Occurrence(subjectMap, contextData, this, contextValues);
 	}
 	else
 	{
@@ -505,7 +783,7 @@ void UPurposeAbilityComponent::ActionPerformed(UGameplayAbility* Ability)
 
 void UPurposeAbilityComponent::AbilityHasFinished(const FContextData& inContext, const EAbilityPurposeFeedback reasonAbilityEnded)
 {
-	inContext.AdjustDataIfPossible(inContext.purpose.DataAdjustments(), EPurposeSelectionEvent::OnFinished, TASK, "ActorFinishedAbility", this);
+	inContext.AdjustDataIfPossible(inContext.Purpose().DataAdjustments(), EPurposeSelectionEvent::OnFinished, TASK, "ActorFinishedAbility", this);
 
 	/// Either the Ability was ended because a new Objective was selected over previous, and previous Objective's Abilities are being ended
 	/// Or we received a new Ability to perform which has OverlappingResources and is taking precedence over this Ability
@@ -515,23 +793,67 @@ void UPurposeAbilityComponent::AbilityHasFinished(const FContextData& inContext,
 		|| reasonAbilityEnded == EAbilityPurposeFeedback::InterruptedByDeath /// In this case we don't have a new purpose already selected, but character is entering death state
 		;
 
-	EPurposeState objectiveState = EPurposeState::None;
+	const FContextData* storedObjective = GetStoredPurpose(inContext.GetContextID(), inContext.addressOfPurpose, (int)EPurposeLayer::Objective);
+	const FContextData* storedGoal = GetStoredPurpose(inContext.GetContextID(), inContext.addressOfPurpose, (int)EPurposeLayer::Goal);
+
+	if (!storedObjective || !storedGoal)
+	{
+		ObjectiveStatusResolved(inContext.GetContextID(), inContext.addressOfPurpose, EPurposeState::Ongoing, shouldNotSeekNewPurpose);/// The incoming ability context was from a reaction, so just return to current Objective for actor
+		return;
+	}
+	const FContextData& objectiveContext = *storedObjective;
 
-	FContextData& objectiveContext = GetStoredPurpose(inContext.GetContextID(), inContext.addressOfPurpose, (int)EPurposeLayer::Objective);
-	FContextData& goalContext = GetStoredPurpose(inContext.GetContextID(), inContext.addressOfPurpose, (int)EPurposeLayer::Goal);
+	if (objectiveContext.Purpose().completionCriteria.Num() <= 0)
+	{
+		ObjectiveStatusResolved(inContext.GetContextID(), inContext.addressOfPurpose, EPurposeState::Ongoing, shouldNotSeekNewPurpose);/// Without conditions we have no way of gauging the state of an Objective
+		return;
+	}
 
-	if (objectiveContext.ContextIsValid() && goalContext.ContextIsValid())
+	/// Evaluate the status of the objective belonging to a chain of purpose on a purpose thread, which continues with CompletionEvaluated
+	const FTrackedPurposeKey checkKey(objectiveContext.GetContextID(), objectiveContext.addressOfPurpose);
+	if (bool* pendingShouldNotSeek = pendingCompletionChecks.Find(checkKey))
+	{
+		*pendingShouldNotSeek = *pendingShouldNotSeek && shouldNotSeekNewPurpose;
+		return;
+	}
+	if (PurposeSystem::QueueCompletionCheck(FCompletionCheck(objectiveContext, this), this))
 	{
-		objectiveState = EvaluateObjectiveStatus(objectiveContext);/// Evaluate the status of the objective belonging to a chain of purpose
-		goalContext.UpdateSubPurposeStatus(objectiveContext.addressOfPurpose, objectiveState);/// Ensure parent context has updated Objective status
+		pendingCompletionChecks.Add(checkKey, shouldNotSeekNewPurpose);
+		return;
+	}
+
+	ObjectiveStatusResolved(inContext.GetContextID(), inContext.addressOfPurpose, EvaluateObjectiveStatus(objectiveContext), shouldNotSeekNewPurpose);
+}
+
+void UPurposeAbilityComponent::CompletionEvaluated(const int64 uniqueContextID, const FPurposeAddress& addressOfPurpose, const EPurposeState status)
+{
+	bool shouldNotSeekNewPurpose = false;
+	if (!pendingCompletionChecks.RemoveAndCopyValue(FTrackedPurposeKey(uniqueContextID, addressOfPurpose), shouldNotSeekNewPurpose))
+	{
+		Global::Log(DATADEBUG, OBJECTIVE, *this, "CompletionEvaluated", TEXT("No completion check pending for %s."), *addressOfPurpose.GetAddressAsString());
+		return;
+	}
+
+	ObjectiveStatusResolved(uniqueContextID, addressOfPurpose, status, shouldNotSeekNewPurpose);
+}
+
+void UPurposeAbilityComponent::ObjectiveStatusResolved(const int64 uniqueContextID, const FPurposeAddress& addressOfPurpose, EPurposeState objectiveState, const bool shouldNotSeekNewPurpose)
+{
+	FContextData* objectiveContext = GetStoredPurpose(uniqueContextID, addressOfPurpose, (int)EPurposeLayer::Objective);
+	FContextData* goalContext = GetStoredPurpose(uniqueContextID, addressOfPurpose, (int)EPurposeLayer::Goal);
+
+	if (objectiveContext && goalContext)
+	{
+		goalContext->UpdateSubPurposeStatus(objectiveContext->addressOfPurpose, objectiveState);/// Ensure parent context has updated Objective status
+		StoredPurposeChanged(*goalContext);
 	}
 	else
 	{
-		objectiveState = EPurposeState::Ongoing;/// The incoming ability context was from a reaction, so just return to current Objective for actor
+		objectiveState = EPurposeState::Ongoing;/// The Objective ended while its status was being checked, or the ability was from a reaction, so just return to current Objective for actor
 	}
 	Global::Log(DATADEBUG, TASK, *this, "ActorFinishedAbility", TEXT("Objective Status: %s. Ability Feedback State: %s")
 		, *Global::EnumValueOnly<EPurposeState>(objectiveState)
-		, *Global::EnumValueOnly<EAbilityPurposeFeedback>(reasonAbilityEnded)
+		, shouldNotSeekNewPurpose ? TEXT("Interrupted") : TEXT("Finished")
 	);
 
 	switch (objectiveState)
@@ -547,13 +869,13 @@ void UPurposeAbilityComponent::AbilityHasFinished(const FContextData& inContext,
 			else
 			{
 				/// If the context has an Objective, then this actor was somehow involved and we want to ensure the data is adjusted to indicate that the Objective lost a participant
-				if (objectiveContext.ContextIsValid()) { objectiveContext.AdjustDataIfPossible(objectiveContext.purpose.DataAdjustments(), EPurposeSelectionEvent::OnFinished, OBJECTIVE, "AbilityHasFinished", this); }
+				if (objectiveContext) { objectiveContext->AdjustDataIfPossible(objectiveContext->Purpose().DataAdjustments(), EPurposeSelectionEvent::OnFinished, OBJECTIVE, "AbilityHasFinished", this); }
 				SelectNewObjectiveFromExistingGoals();/// No valid current objective, get a new one
 			}
 			break;
-		case EPurposeState::Complete:/// If the Objective is complete, evaluate status of Goal
+		case EPurposeState::Complete:/// If the Objective is complete, evaluate status of Goal, both are stored as the state would otherwise be Ongoing
 			{
-				EPurposeState goalState = EvaluateGoalStatus(goalContext);
+				EPurposeState goalState = EvaluateGoalStatus(*goalContext);
 				Global::Log(DATADEBUG, TASK, *this, "ActorFinishedAbility", TEXT("Goal Status: %s"), *Global::EnumValueOnly<EPurposeState>(goalState));
 
 				/// We don't check shouldNotSeekNewPurpose here because we want to perform GoalComplete logic if necessary
@@ -561,26 +883,25 @@ void UPurposeAbilityComponent::AbilityHasFinished(const FContextData& inContext,
 				{
 					case EPurposeState::Complete:/// If the Goal was completed, notify Director, then compile objectives from remaining goals for actor to select
 
-						FContextData& eventContext = GetStoredPurpose(inContext.GetContextID(), inContext.addressOfPurpose, (int)EPurposeLayer::Event);
-
-						eventContext.UpdateSubPurposeStatus(goalContext.addressOfPurpose, goalState);/// Ensure parent context has updated Goal status
-
-						bool bAllPurposeComplete = false;
-
-						for (auto subStatus : eventContext.subPurposeStatus)
+						if (FContextData* eventContext = GetStoredPurpose(uniqueContextID, addressOfPurpose, (int)EPurposeLayer::Event))
 						{
-							if (subStatus.Value != EPurposeState::Complete)
+							eventContext->UpdateSubPurposeStatus(goalContext->addressOfPurpose, goalState);/// Ensure parent context has updated Goal status
+							StoredPurposeChanged(*eventContext);
+
+							const bool bAllPurposeComplete = eventContext->subPurposes.AllComplete();
+							if (bAllPurposeComplete)
 							{
-								break;
+								eventContext->purposeOwner->AllSubPurposesComplete(eventContext->GetContextID(), eventContext->addressOfPurpose);
 							}
 
-							bAllPurposeComplete = true;
-							eventContext.purposeOwner->AllSubPurposesComplete(eventContext.GetContextID(), eventContext.addressOfPurpose);
+							if (!bAllPurposeComplete && goalState == EPurposeState::Complete)
+							{
+								eventContext->purposeOwner->SubPurposeCompleted(goalContext->GetContextID(), goalContext->addressOfPurpose);
+							}
 						}
-
-						if (!bAllPurposeComplete && goalState == EPurposeState::Complete)
+						else
 						{
-							eventContext.purposeOwner->SubPurposeCompleted(goalContext.GetContextID(), goalContext.addressOfPurpose);
+							Global::LogError(GOAL, *this, "ObjectiveStatusResolved", TEXT("The Event of %s is no longer tracked!"), *goalContext->GetPurposeChainName());
 						}
 
 						if (shouldNotSeekNewPurpose) { return; }/// We return because we don't wish to find a new Objective or new Ability, as one or the other was already selected for inActor and that's why this Ability ended
@@ -614,28 +935,31 @@ EPurposeState UPurposeAbilityComponent::EvaluateObjectiveStatus(const FContextDa
 		/// What if we used the current conditions, and possibly the score cache?
 		/// It has to be accessible from anywhere. Currently stored event assets are held on the level director
 
-	if (contextOfObjective.purpose.completionCriteria.Num() <= 0)
+	if (contextOfObjective.Purpose().completionCriteria.Num() <= 0)
 	{
 		objectiveStatus = EPurposeState::Ongoing;/// Without conditions we have no way of gauging the state of an Objective
 	}
 	else
 	{
-		for (const TObjectPtr<UCondition> condition : contextOfObjective.purpose.completionCriteria)///Score each condition and add to finalscore of purpose
+		/// Copied once and shared by every criterion
+		TMap<ESubject, TArray<FDataMapEntry>> subjectsWithoutPointers;
+		subjectsWithoutPointers.Add(ESubject::Context, contextOfObjective.contextData);
+		subjectsWithoutPointers.Append(contextOfObjective.subjectMap.GetSubjectsAsDataMaps());
+		FPurposeEvaluationThread::FScopedContextValues contextValuesScope(contextOfObjective.contextValues);/// So criteria read the inline values of the context just as they do on a purpose thread
+
+		for (const TObjectPtr<UCondition> condition : contextOfObjective.Purpose().completionCriteria)///Score each condition and add to finalscore of purpose
 		{
 			if (!condition)
 			{
 				Global::LogError(OBJECTIVE, *this, "EvaluateObjectiveStatus", TEXT("Context->ParentPurpose->completionCriteria returned an invalid object."));
 				continue;
 			}
-			TMap<ESubject, TArray<FDataMapEntry>> subjectsWithoutPointers;
-			subjectsWithoutPointers.Add(ESubject::Context, contextOfObjective.contextData);
-			subjectsWithoutPointers.Append(contextOfObjective.subjectMap.GetSubjectsAsDataMaps());
 			score += condition->EvaluateCondition(subjectsWithoutPointers, contextOfObjective.purposeOwner, contextOfObjective.GetContextID(), contextOfObjective.addressOfPurpose);///Get a baseline 0-1 score for condition
 			////Global::Log(Debug, PurposeLog, "FPurposeEvaluationThread", "EvaluatePurpose", TEXT("Score for Condition: %s = %f; Potential Score = %f."), *condition->description.ToString(), score, potentialScore);
 		}
 
 		/// Scoring for completion criteria is meant to be more yes/no than scoring for purpose selection conditions.
-		finalScore = score / contextOfObjective.purpose.completionCriteria.Num();/// Get the average score
+		finalScore = score / contextOfObjective.Purpose().completionCriteria.Num();/// Get the average score
 
 		if (finalScore == 1) { objectiveStatus = EPurposeState::Complete; }
 		if (finalScore < 1) { objectiveStatus = EPurposeState::Ongoing; }
@@ -648,17 +972,7 @@ EPurposeState UPurposeAbilityComponent::EvaluateObjectiveStatus(const FContextDa
 
 EPurposeState UPurposeAbilityComponent::EvaluateGoalStatus(const FContextData& contextOfGoal)
 {
-	EPurposeState state = EPurposeState::Complete;
-
-	for (auto objective : contextOfGoal.subPurposeStatus)
-	{
-		if (objective.Value == EPurposeState::Ongoing)
-		{
-			state = EPurposeState::Ongoing;/// So long as a single objective is Ongoing, Goal is incomplete
-		}
-	}
-
-	return state;
+	return contextOfGoal.subPurposes.NumIncomplete() > 0 ? EPurposeState::Ongoing : EPurposeState::Complete;/// So long as a single objective is Ongoing, Goal is incomplete
 }
 
 void UPurposeAbilityComponent::SelectNewObjectiveFromExistingGoals()
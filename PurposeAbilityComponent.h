@@ -7,6 +7,9 @@
 #include "AbilitySystem/LyraAbilitySystemComponent.h"
 #include "Purpose/Abilities/GA_PurposeBase.h"
 #include "Purpose/PurposeEvaluationThread.h"
+#include "Purpose/PurposeReplicatedDataMap.h"
+#include "Purpose/PurposeContextStore.h"
+#include "Purpose/PurposeTrackedPurposeStore.h"
 #include "PurposeAbilityComponent.generated.h"
 
 UCLASS()
@@ -24,12 +27,24 @@ public:
 	/// Enforces necessity for providing reqs to PurposeSystem
 	void InitializePurposeSystem(TObjectPtr<class AManager> inManager);
 
+	/// Ensures the component no longer appears on the world state blackboard
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/// The avatar may be set after possession has changed, so the actors standing for us are refreshed here as well
+	virtual void InitAbilityActorInfo(AActor* InOwnerActor, AActor* InAvatarActor) override;
+
+	/// Syncs the replicated data map with any changes to data since the last net update
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
 	TObjectPtr<class AManager> Manager() { return manager; }
 	
-	bool HasCurrentObjective() { return currentObjectiveForOwner.ContextIsValid(); }
+	bool HasCurrentObjective() { return CurrentObjective().ContextIsValid(); }
+
+	/// @return const FContextData&: The context held by the context store for currentObjective, a shared invalid context if there is none
+	const FContextData& CurrentObjective();
 
-	FContextData& CurrentObjective() { return currentObjectiveForOwner; }
-	void SetCurrentObjective(FContextData inContext) { currentObjectiveForOwner = inContext; }
+	/// Releases the previous objective from the context store, then stores inContext if it is valid
+	void SetCurrentObjective(FContextData inContext);
 
 	//TObjectPtr<ACharacter> GetOwnerCharacter() { return Cast<ACharacter>(GetOwner()); }
 	TObjectPtr<ACharacter> GetOwnerCharacter() { return Cast<ACharacter>(Cast<AController>(GetOwner())->GetPawn()); }
@@ -44,7 +59,39 @@ protected:
 
 	TObjectPtr<class AManager> manager = nullptr;
 
-	FContextData currentObjectiveForOwner;
+	/// The Objective itself lives in the head of purpose management's FPurposeContextStore
+	FContextHandle currentObjective;
+
+	/// Objectives awaiting the result of a completion check, by context ID and address, with whether the finished abilities forbid seeking a new purpose
+	/// Abilities finishing while a check is pending share its result rather than queuing another
+	/// The context ID keeps a result meant for an Objective of an ended context tree from resolving a newer Objective at the same address
+	TMap<FTrackedPurposeKey, bool> pendingCompletionChecks;
+
+	/// Keeps our entry of the head of purpose management's FPurposeSpatialGrid at the location of our avatar
+	void AvatarMoved(USceneComponent* movedComponent, EUpdateTransformFlags updateTransformFlags, ETeleportType teleport);
+
+	/// The root of the avatar bound to AvatarMoved, as the avatar may change
+	TWeakObjectPtr<USceneComponent> movingAvatarRoot;
+	FDelegateHandle avatarMovedHandle;
+
+	/// Binds AvatarMoved to the root of our current avatar in place of the last, and places us in the spatial grid at its location, or removes us from the grid while we have none
+	void BindAvatar();
+
+	/// Registers our owner, avatar, and the pawn, controller and player state related to them with the head of purpose management's FPurposeComponentRegistry
+	/// Replaces whatever was registered before, so is repeated whenever possession changes which actors stand for us
+	void RegisterStandInActors();
+
+	/// Re-registers the actors standing for us and rebinds our avatar, once possession or the avatar has changed
+	void StandInActorsChanged();
+
+	/// Bound to the possession delegates of our owner, see InitializePurposeSystem
+	/// A player state is bound through its own OnPawnSet, as its owning controller may itself change
+	UFUNCTION()
+	void PossessedPawnChanged(APawn* oldPawn, APawn* newPawn);
+	UFUNCTION()
+	void ControllerChanged(APawn* pawn, AController* oldController, AController* newController);
+	UFUNCTION()
+	void PlayerStatePawnSet(class APlayerState* playerState, APawn* newPawn, APawn* oldPawn);
 
 #pragma region Datamap Interface
 public:
@@ -52,14 +99,38 @@ public:
 
 private:
 
-	UPROPERTY(Replicated)
+	UPROPERTY()
 	///This data is representative of the subject "ESubject::Candidate"
+	/// Replicated through replicatedData, so that only changed entries are sent
 	TArray<FDataMapEntry> data;
 
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedData)
+	FReplicatedDataMap replicatedData;
+
+	UPROPERTY()
+	/// Chunks created within our data map by data adjustments, recycled as they are removed or replaced
+	FDataChunkPool dataChunkPool;
+
+	UFUNCTION()
+	void OnRep_ReplicatedData();
+
 	/// Force implementers to provide an editable datamap
 	/// The only way to the change the DataMap is through the Server RPCs or server side calls
+	/// Free of side effects, as lookups pass through here too, the data map version is raised by AddData, AppendData and RemoveData instead
 	TArray<FDataMapEntry>& DataMapInternal() final { return data; }
 
+public:
+
+	/// Each also returns any pooled chunk removed or replaced to the data chunk pool
+	void AddData(UDataChunk* inData, bool overwriteValue = true) override;
+	void AppendData(const TArray<FDataMapEntry>& inDataMap, bool overwriteValue = true) override;
+	void RemoveData(TSubclassOf<UDataChunk> inClass) override;
+
+private:
+
+	/// Raised whenever the data map may have changed, allowing the blackboard to reuse its last copy until it does
+	uint32 dataMapVersion = 0;
+
 #pragma endregion
 
 #pragma region Gameplay Abilities
@@ -157,6 +228,21 @@ public:
 
 	TArray<FPurposeEvaluationThread*> GetBackgroundPurposeThreads() final;
 
+	FPurposeBlackboard* GetWorldStateBlackboard() final;
+
+	FDataChunkPool* GetDataChunkPool() final { return &dataChunkPool; }
+
+	FPurposeContextStore* GetContextStore() final;
+
+	FContextTreeRegistry* GetContextTreeRegistry() final;
+
+	FPurposeSpatialGrid* GetSpatialGrid() final;
+
+	FPurposeComponentRegistry* GetPurposeComponentRegistry() final;
+
+	uint32 DataMapVersion() const final { return dataMapVersion; }
+	void IncrementDataMapVersion() final { ++dataMapVersion; }
+
 	TArray<TScriptInterface<IDataMapInterface>> GetCandidatesForSubPurposeSelection(const int PurposeLayerForUniqueSubjects) final;
 
 	/// @param PurposeLayerForUniqueSubjects: Represents the purpose layer for which the PurposeOwner is meant to create new FUniqueSubjectMaps
@@ -168,19 +254,21 @@ public:
 	bool ProvidePurposeToOwner(const FContextData& purposeToStore) final;
 
 	/// Events must be stored globally for the duration of a game so that they may have a consistent PurposeAddress
-	TArray<FPurpose> GetEventAssets() final;
-
-	/// As FPurpose can not hold an variable or TArray<> of itself, we're forced to workaround simply accessing subpurposes
-	TArray<FPurpose> GetSubPurposesFor(FPurposeAddress address) final;
+	FCompiledPurposeTreePtr GetPurposeTree() final;
 
 	/// When a purpose is put up for selection, but it appears to be a duplicate of a current purpose, we want to let the purpose owner handle the reoccurrence
 	void PurposeReOccurrence(const FPurposeAddress addressOfPurpose, const int64 uniqueIDofActivePurpose) final;
 
+	/// The completion status of an Objective checked on a purpose thread on behalf of AbilityHasFinished
+	void CompletionEvaluated(const int64 uniqueContextID, const FPurposeAddress& addressOfPurpose, const EPurposeState status) final;
+
 	/// @param uniqueIdentifierOfContextTree: This ID unique to a series of context datas starting with Event allows separation of same purposes for different contexts
 	/// @param fullAddress: Tying the address to the unique ID is how we can search stored contexts for the relevant context we seek
 	/// @param layerToRetrieveFor: We may not necessarily wish to find the end address of the fullAddress, so we can indicate a layer to seek out
-	/// @return FContextData&: Need to check for validity as the context data may not have been found and an empty struct returned
-	FContextData& GetStoredPurpose(const int64 uniqueIdentifierOfContextTree, const FPurposeAddress& fullAddress, const int layerToRetrieveFor) override;
+	/// @return FContextData*: The stored context itself, nullptr if it was not found
+	FContextData* GetStoredPurpose(const int64 uniqueIdentifierOfContextTree, const FPurposeAddress& fullAddress, const int layerToRetrieveFor) override;
+
+	void StoredPurposeChanged(const FContextData& storedContext) override;
 
 	/// @param parentAddress: An address which is either that of a purpose containing behaviors so that it may reference the parent, or the parent address itself
 	/// @param TArray<TObjectPtr<UGA_Behavior>>: All the behaviors contained by the parent indicated
@@ -191,7 +279,7 @@ public:
 	TObjectPtr<class UBehavior_AI> GetBehaviorAtAddress(const FPurposeAddress& inAddress) final { return GetHeadOfPurposeManagment()->GetBehaviorAtAddress(inAddress); }
 
 	///@return bool: True when the target and candidate are the same
-	bool DoesPurposeAlreadyExist(const FContextData& primary, const FSubjectMap& secondarySubjects, const TArray<FDataMapEntry>& secondaryContext, const FPurposeAddress optionalAddress = FPurposeAddress()) final;
+	bool DoesPurposeAlreadyExist(const FContextData& primary, const FSubjectMap& secondarySubjects, const TArray<FDataMapEntry>& secondaryContext, const FInlineDataMap& secondaryValues, const FPurposeAddress optionalAddress = FPurposeAddress()) final;
 
 #pragma endregion
 
@@ -210,6 +298,10 @@ public:
 	/// Manager will begin evaluation of state of Purpose Chain
 	void AbilityHasFinished(const FContextData& inContext, const EAbilityPurposeFeedback reasonAbilityEnded);
 
+	/// Continues AbilityHasFinished once the status of the Objective is known, whether checked on a purpose thread or not
+	void ObjectiveStatusResolved(const int64 uniqueContextID, const FPurposeAddress& addressOfPurpose, EPurposeState objectiveState, const bool shouldNotSeekNewPurpose);
+
+	/// Only used when no purpose thread accepts the completion check
 	/// @return EPurposeState::Complete if parent ObjectiveContext->CompletionCriteria indicate completion
 	EPurposeState EvaluateObjectiveStatus(const FContextData& contextOfObjective);
 
@@ -0,0 +1,135 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+
+#include "Purpose/PurposeBlackboard.h"
+#include "GlobalLog.h"
+#include "Purpose/PurposeEvaluationThread.h"
+
+int32 FPurposeBlackboard::RegisterEntity(TScriptInterface<IDataMapInterface> entity)
+{
+	if (!IsValid(entity.GetObject()))
+	{
+		Global::LogError(PURPOSE, "FPurposeBlackboard", "RegisterEntity", TEXT("Attempting to register an invalid data map!"));
+		return INDEX_NONE;
+	}
+
+	if (const int32* existingIndex = entityIndices.Find(entity.GetObject()))
+	{
+		return *existingIndex;
+	}
+
+	const int32 entityIndex = freeEntityIndices.Num() > 0 ? freeEntityIndices.Pop(false) : entities.AddDefaulted();
+
+	FBlackboardEntity& registeredEntity = entities[entityIndex];
+	const uint32 generation = registeredEntity.generation;
+	registeredEntity = FBlackboardEntity();
+	registeredEntity.generation = generation;
+	registeredEntity.dataMap = TWeakInterfacePtr<IDataMapInterface>(entity.GetObject());
+	registeredEntity.versionSource = Cast<IPurposeManagementInterface>(entity.GetObject());/// Without a version we have no choice but to copy every publish
+	entityIndices.Add(entity.GetObject(), entityIndex);
+
+	Global::Log(DATADEBUG, PURPOSE, "FPurposeBlackboard", "RegisterEntity", TEXT("Registered %s at index %d.")
+		, *entity.GetObject()->GetName()
+		, entityIndex
+	);
+
+	return entityIndex;
+}
+
+void FPurposeBlackboard::UnregisterEntity(const UObject* entity)
+{
+	int32 entityIndex = INDEX_NONE;
+	if (!entityIndices.RemoveAndCopyValue(entity, entityIndex))
+	{
+		return;
+	}
+
+	const uint32 generation = entities[entityIndex].generation + 1;/// Requests already queued with this index must no longer read it
+	entities[entityIndex] = FBlackboardEntity();
+	entities[entityIndex].generation = generation;
+	freeEntityIndices.Add(entityIndex);
+}
+
+FBlackboardHandle FPurposeBlackboard::EntityHandleOf(const UObject* entity) const
+{
+	const int32* entityIndex = entityIndices.Find(entity);
+	return entityIndex ? FBlackboardHandle(*entityIndex, entities[*entityIndex].generation) : FBlackboardHandle();
+}
+
+void FPurposeBlackboard::Publish()
+{
+	check(IsInGameThread());
+
+	const int32 backBufferIndex = 1 - frontBufferIndex;
+	TSharedPtr<FPurposeBlackboardSnapshot, ESPMode::ThreadSafe>& backBuffer = buffers[backBufferIndex];
+
+	/// A background thread may still be evaluating against the old front buffer
+	/// Rather than waiting on it, we simply leave it to them and start a fresh back buffer
+	if (!backBuffer.IsValid() || !backBuffer.IsUnique())
+	{
+		backBuffer = MakeShared<FPurposeBlackboardSnapshot, ESPMode::ThreadSafe>();
+		publishedSnapshots.Add(backBuffer);/// A reused back buffer is already tracked, and takes on its new publish number
+	}
+
+	numCopiedOnLastPublish = 0;
+	numReusedOnLastPublish = 0;
+
+	backBuffer->dataMaps.SetNum(entities.Num());
+	backBuffer->generations.SetNum(entities.Num());
+	for (int32 entityIndex = 0; entityIndex < entities.Num(); ++entityIndex)
+	{
+		FBlackboardEntity& entity = entities[entityIndex];
+		backBuffer->generations[entityIndex] = entity.generation;
+		IDataMapInterface* dataMap = entity.dataMap.Get();
+		if (!dataMap)
+		{
+			entity.publishedDataMap.Reset();
+			backBuffer->dataMaps[entityIndex].Reset();
+			continue;
+		}
+
+		/// Copy cost should scale with how often the data changes, not with how often we publish
+		const bool bUnchanged = entity.publishedDataMap.IsValid() && entity.versionSource && entity.versionSource->DataMapVersion() == entity.publishedVersion;
+		if (bUnchanged)
+		{
+			++numReusedOnLastPublish;
+		}
+		else
+		{
+			entity.publishedDataMap = MakeShared<const TArray<FDataMapEntry>, ESPMode::ThreadSafe>(dataMap->DataMap());
+			entity.publishedVersion = entity.versionSource ? entity.versionSource->DataMapVersion() : 0;
+			++numCopiedOnLastPublish;
+		}
+
+		backBuffer->dataMaps[entityIndex] = entity.publishedDataMap;
+	}
+	backBuffer->frameOfPublish = GFrameCounter;
+	backBuffer->publishNumber = ++numPublished;
+
+	FScopeLock lock(&frontBufferLock);
+	frontBufferIndex = backBufferIndex;
+}
+
+FPurposeBlackboardSnapshotPtr FPurposeBlackboard::Front() const
+{
+	FScopeLock lock(&frontBufferLock);
+	return buffers[frontBufferIndex];
+}
+
+uint64 FPurposeBlackboard::OldestLivePublish()
+{
+	check(IsInGameThread());
+
+	uint64 oldestPublish = numPublished + 1;/// Nothing is held before the first publish
+	for (int32 i = publishedSnapshots.Num() - 1; i >= 0; --i)
+	{
+		TSharedPtr<FPurposeBlackboardSnapshot, ESPMode::ThreadSafe> snapshot = publishedSnapshots[i].Pin();
+		if (!snapshot.IsValid())
+		{
+			publishedSnapshots.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+		oldestPublish = FMath::Min(oldestPublish, snapshot->publishNumber);
+	}
+	return oldestPublish;
+}
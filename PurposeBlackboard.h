@@ -0,0 +1,151 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data.h"
+#include "DataMapInterface.h"
+#include "UObject/WeakInterfacePtr.h"
+#include "Templates/SharedPointer.h"
+#include "HAL/CriticalSection.h"
+
+class IPurposeManagementInterface;
+
+typedef TSharedPtr<const TArray<FDataMapEntry>, ESPMode::ThreadSafe> FPublishedDataMapPtr;
+
+/// The index of an entity within every snapshot, paired with the generation of the registration it was resolved from
+/// Indices are reused once an entity unregisters, so a handle resolved before then must not read whichever entity took the index
+struct FBlackboardHandle
+{
+	FBlackboardHandle() {}
+	FBlackboardHandle(const int32 inIndex, const uint32 inGeneration)
+		: index(inIndex)
+		, generation(inGeneration)
+	{}
+
+	int32 index = INDEX_NONE;
+
+	/// Raised each time the index is freed
+	uint32 generation = 0;
+
+	bool IsSet() const { return index != INDEX_NONE; }
+};
+
+/// <summary>
+/// A single published copy of the data maps of every entity registered with the blackboard
+/// Once published it is never written to again, so background threads can read it without touching the live UObjects
+/// </summary>
+struct FPurposeBlackboardSnapshot
+{
+	/// Indexed by the entity index handed out by FPurposeBlackboard::RegisterEntity
+	/// Unregistered slots are left null
+	/// Data maps which did not change between publishes are shared with the previous snapshot rather than copied again
+	TArray<FPublishedDataMapPtr> dataMaps;
+
+	/// Parallel to dataMaps, the generation of the entity each data map was captured from
+	TArray<uint32> generations;
+
+	/// The frame this snapshot was published on, useful when debugging stale reads
+	uint64 frameOfPublish = 0;
+
+	/// Counts up with every publish, see FPurposeBlackboard::OldestLivePublish
+	uint64 publishNumber = 0;
+
+	/// @return bool: False if the index has since been handed to another entity, the handle's entity then being gone
+	bool IsCurrent(const FBlackboardHandle& handle) const
+	{
+		return !generations.IsValidIndex(handle.index) || generations[handle.index] == handle.generation;
+	}
+
+	/// @return const TArray<FDataMapEntry>*: nullptr if the entity was not yet published or the handle is stale
+	const TArray<FDataMapEntry>* DataMapFor(const FBlackboardHandle& handle) const
+	{
+		return dataMaps.IsValidIndex(handle.index) && IsCurrent(handle) ? dataMaps[handle.index].Get() : nullptr;
+	}
+};
+
+typedef TSharedPtr<const FPurposeBlackboardSnapshot, ESPMode::ThreadSafe> FPurposeBlackboardSnapshotPtr;
+
+/// <summary>
+/// The blackboard is a double-buffered copy of the world state relevant to purpose evaluation
+/// Once per tick the game thread writes every registered data map to the back buffer and swaps it to the front
+/// Background threads only ever read the front buffer by entity index, so requests carry indices rather than their own copies of each subject
+/// </summary>
+class FPurposeBlackboard
+{
+public:
+
+	/// Game thread only
+	/// @return int32: The index of the entity within every snapshot, INDEX_NONE if the entity is invalid
+	int32 RegisterEntity(TScriptInterface<IDataMapInterface> entity);
+
+	/// Game thread only. The index is recycled for the next registered entity
+	void UnregisterEntity(const UObject* entity);
+
+	/// Game thread only
+	/// @return FBlackboardHandle: Unset when the entity was never registered
+	FBlackboardHandle EntityHandleOf(const UObject* entity) const;
+
+	/// Game thread only. Copies every changed data map into the back buffer, then swaps it to the front
+	/// A data map whose IPurposeManagementInterface::DataMapVersion() has not changed since it was last captured is reused as is
+	void Publish();
+
+	/// Safe from any thread. The returned snapshot remains valid for as long as the caller holds it, regardless of later publishes
+	FPurposeBlackboardSnapshotPtr Front() const;
+
+	/// Game thread only
+	/// @return uint64: The publish number of the latest snapshot, 0 before the first publish
+	uint64 NumPublished() const { return numPublished; }
+
+	/// Game thread only. Anything removed from a data map after publish N is unreachable by any thread once this exceeds N
+	/// @return uint64: The publish number of the oldest snapshot still held by any thread
+	uint64 OldestLivePublish();
+
+	int32 NumEntities() const { return entityIndices.Num(); }
+
+	/// How many data maps the last publish actually had to copy, against how many were reused
+	int32 NumCopiedOnLastPublish() const { return numCopiedOnLastPublish; }
+	int32 NumReusedOnLastPublish() const { return numReusedOnLastPublish; }
+
+private:
+
+	struct FBlackboardEntity
+	{
+		TWeakInterfacePtr<IDataMapInterface> dataMap;
+
+		/// The same object as dataMap, when it implements IPurposeManagementInterface
+		/// Only dereferenced while dataMap is valid
+		IPurposeManagementInterface* versionSource = nullptr;
+
+		/// The version of the data map at the time publishedDataMap was captured
+		uint32 publishedVersion = 0;
+
+		/// The last captured copy, shared by every snapshot until the version changes
+		FPublishedDataMapPtr publishedDataMap;
+
+		/// Kept when the entity is reset, raised as its index is freed
+		uint32 generation = 0;
+	};
+
+	/// Indexed by entity index, invalid entries are free slots awaiting reuse
+	TArray<FBlackboardEntity> entities;
+
+	TArray<int32> freeEntityIndices;
+
+	TMap<const UObject*, int32> entityIndices;
+
+	/// The two buffers we alternate between, frontBufferIndex points at the one readers currently see
+	TSharedPtr<FPurposeBlackboardSnapshot, ESPMode::ThreadSafe> buffers[2];
+	int32 frontBufferIndex = 0;
+
+	/// Guards frontBufferIndex against a background thread reading the front while the game thread swaps
+	mutable FCriticalSection frontBufferLock;
+
+	uint64 numPublished = 0;
+
+	/// Every snapshot published which a thread may still hold, pruned as they are released
+	TArray<TWeakPtr<FPurposeBlackboardSnapshot, ESPMode::ThreadSafe>> publishedSnapshots;
+
+	int32 numCopiedOnLastPublish = 0;
+	int32 numReusedOnLastPublish = 0;
+};
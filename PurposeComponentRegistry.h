@@ -0,0 +1,67 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Purpose/PurposeAbilityComponent.h"
+
+/// <summary>
+/// Maps every actor standing for a purpose component, such as its owner, pawn, controller and player state, to that component
+/// Allows targeting to resolve an actor found in the world to its component with a single lookup, rather than searching the components of each related actor
+/// Filled as a component joins the purpose system and emptied as it ends play
+/// Owned by the head of purpose management, see IPurposeManagementInterface::GetPurposeComponentRegistry
+/// Game thread only
+/// </summary>
+struct FPurposeComponentRegistry
+{
+public:
+
+	/// Replaces any actors previously registered for the component
+	void Register(UPurposeAbilityComponent* component, TArrayView<AActor* const> actors)
+	{
+		Unregister(component);
+
+		TArray<TObjectKey<AActor>>& registeredActors = actorsOf.Add(component);
+		for (AActor* actor : actors)
+		{
+			if (IsValid(actor) && !registeredActors.Contains(actor))
+			{
+				registeredActors.Add(actor);
+				componentOf.Add(actor, component);
+			}
+		}
+	}
+
+	void Unregister(const UPurposeAbilityComponent* component)
+	{
+		TArray<TObjectKey<AActor>> registeredActors;
+		if (actorsOf.RemoveAndCopyValue(component, registeredActors))
+		{
+			for (const TObjectKey<AActor>& actor : registeredActors)
+			{
+				/// Another component may since have registered the actor, such as the player state of a repossessed pawn
+				const TWeakObjectPtr<UPurposeAbilityComponent>* registered = componentOf.Find(actor);
+				if (registered && registered->Get() == component)
+				{
+					componentOf.Remove(actor);
+				}
+			}
+		}
+	}
+
+	/// @return UPurposeAbilityComponent*: nullptr if the actor stands for no component
+	UPurposeAbilityComponent* Find(const AActor* actor) const
+	{
+		const TWeakObjectPtr<UPurposeAbilityComponent>* component = componentOf.Find(actor);
+		return component ? component->Get() : nullptr;
+	}
+
+	int32 Num() const { return actorsOf.Num(); }
+
+private:
+
+	TMap<TObjectKey<AActor>, TWeakObjectPtr<UPurposeAbilityComponent>> componentOf;
+
+	/// Kept so unregistering removes exactly the actors registered
+	TMap<TObjectKey<UPurposeAbilityComponent>, TArray<TObjectKey<AActor>>> actorsOf;
+};
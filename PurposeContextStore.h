@@ -0,0 +1,116 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Purpose/PurposeEvaluationThread.h"
+
+/// <summary>
+/// A plain reference to a context held by FPurposeContextStore
+/// Copying a handle copies three integers, where copying FContextData copies its subject map, data and names
+/// A handle whose context has since been released resolves to nothing, rather than to whichever context reused the slot
+/// </summary>
+struct FContextHandle
+{
+	FContextHandle() {}
+	FContextHandle(const uint32 inSlot, const uint32 inGeneration, const FPurposeAddress& inAddress)
+		: slot(inSlot)
+		, generation(inGeneration)
+		, address(inAddress)
+	{}
+
+	uint32 slot = 0;
+
+	/// 0 is never handed out, so a default handle is never valid
+	uint32 generation = 0;
+
+	/// The address of the context, available without resolving the handle
+	FPurposeAddress address;
+
+	bool IsSet() const { return generation != 0; }
+
+	FORCEINLINE bool operator ==(const FContextHandle& other) const
+	{
+		return slot == other.slot && generation == other.generation;
+	}
+};
+FORCEINLINE uint32 GetTypeHash(const FContextHandle& handle)
+{
+	return HashCombine(GetTypeHash(handle.slot), GetTypeHash(handle.generation));
+}
+
+/// <summary>
+/// Owns contexts which would otherwise be copied between every holder, such as the current objective of each purpose component
+/// Owned by the head of purpose management, see IPurposeManagementInterface::GetContextStore
+/// Slots are reused once released, each reuse raising the slot's generation so outstanding handles to the old context become stale
+/// Game thread only
+/// </summary>
+struct FPurposeContextStore
+{
+public:
+
+	FContextHandle Add(FContextData&& context)
+	{
+		uint32 slot = 0;
+		if (freeSlots.Num() > 0)
+		{
+			slot = freeSlots.Pop(false);
+			*contexts[slot] = MoveTemp(context);
+		}
+		else
+		{
+			slot = contexts.Add(MakeUnique<FContextData>(MoveTemp(context)));
+			generations.Add(1);/// 0 marks an unset handle
+		}
+		return FContextHandle(slot, generations[slot], contexts[slot]->addressOfPurpose);
+	}
+
+	/// @return FContextData*: nullptr if the handle is unset or its context has been released
+	FContextData* Get(const FContextHandle& handle) const
+	{
+		return IsCurrent(handle) ? contexts[handle.slot].Get() : nullptr;
+	}
+
+	bool IsCurrent(const FContextHandle& handle) const
+	{
+		return handle.IsSet() && generations.IsValidIndex(handle.slot) && generations[handle.slot] == handle.generation;
+	}
+
+	/// Resets the context so anything it held, such as the purpose tree, is let go, but keeps its allocation for the next Add
+	bool Release(const FContextHandle& handle)
+	{
+		if (!IsCurrent(handle))
+		{
+			return false;
+		}
+
+		*contexts[handle.slot] = FContextData();
+		freeSlots.Add(handle.slot);
+
+		/// Raised on release rather than reuse, so handles to this context are stale while the slot sits free
+		if (++generations[handle.slot] == 0)
+		{
+			generations[handle.slot] = 1;
+		}
+		return true;
+	}
+
+	int32 Num() const { return contexts.Num() - freeSlots.Num(); }
+
+	/// Searches every context, so is only meant for infrequent checks such as whether an Event may be unloaded
+	bool AnyBelongToEvent(const FPurposeAddress& eventAddress) const
+	{
+		/// Released contexts are reset, and so have no address layers to match
+		return contexts.ContainsByPredicate([&eventAddress](const TUniquePtr<FContextData>& context) { return context->addressOfPurpose.GetAddressLayer() > 0 && context->addressOfPurpose.Truncate(1) == eventAddress; });
+	}
+
+private:
+
+	/// Allocated individually so an FContextData& remains valid while other contexts are added
+	TArray<TUniquePtr<FContextData>> contexts;
+
+	/// Parallel to contexts, the generation handed out by the next Add of each slot while it is free
+	TArray<uint32> generations;
+
+	TArray<uint32> freeSlots;
+};
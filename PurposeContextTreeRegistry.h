@@ -0,0 +1,87 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Purpose/PurposeEvaluationThread.h"
+
+/// Everything known of a single context tree, found by its ID
+struct FContextTreeEntry
+{
+	/// The Event context at the root of the tree, owned by the head of purpose management's tracked purposes
+	FContextData* root = nullptr;
+
+	/// Every purpose owner below the head tracking a context of this tree, such as the managers holding its Goals
+	/// Weak, as a participant may be destroyed without having removed itself
+	TArray<TWeakInterfacePtr<IPurposeManagementInterface>> participants;
+};
+
+/// <summary>
+/// Maps the ID of every active context tree to its root Event and the owners taking part in it
+/// Allows re-occurrences and completions to reach exactly the owners involved, rather than asking every owner whether it holds the tree
+/// Owned by the head of purpose management, game thread only
+/// </summary>
+struct FContextTreeRegistry
+{
+public:
+
+	/// @param root: Must remain valid until Unregister is called for its ID
+	void Register(FContextData& root)
+	{
+		trees.FindOrAdd(root.GetContextID()).root = &root;
+	}
+
+	void Unregister(const int64 contextID)
+	{
+		trees.Remove(contextID);
+	}
+
+	void AddParticipant(const int64 contextID, TScriptInterface<IPurposeManagementInterface> participant)
+	{
+		if (FContextTreeEntry* entry = trees.Find(contextID))
+		{
+			entry->participants.RemoveAllSwap([](const TWeakInterfacePtr<IPurposeManagementInterface>& existing) { return !existing.IsValid(); });/// Drop any participant destroyed since
+			entry->participants.AddUnique(TWeakInterfacePtr<IPurposeManagementInterface>(participant.GetObject()));
+		}
+	}
+
+	void RemoveParticipant(const int64 contextID, TScriptInterface<IPurposeManagementInterface> participant)
+	{
+		if (FContextTreeEntry* entry = trees.Find(contextID))
+		{
+			entry->participants.RemoveSingleSwap(TWeakInterfacePtr<IPurposeManagementInterface>(participant.GetObject()));
+		}
+	}
+
+	/// @return FContextData*: The root Event of the tree, nullptr if the tree is not active
+	FContextData* FindRoot(const int64 contextID) const
+	{
+		const FContextTreeEntry* entry = trees.Find(contextID);
+		return entry ? entry->root : nullptr;
+	}
+
+	/// Copied, as participants commonly remove themselves as they are notified
+	/// @return TArray<TScriptInterface<IPurposeManagementInterface>>: Only the participants still valid
+	TArray<TScriptInterface<IPurposeManagementInterface>> ParticipantsOf(const int64 contextID) const
+	{
+		TArray<TScriptInterface<IPurposeManagementInterface>> validParticipants;
+		if (const FContextTreeEntry* entry = trees.Find(contextID))
+		{
+			validParticipants.Reserve(entry->participants.Num());
+			for (const TWeakInterfacePtr<IPurposeManagementInterface>& participant : entry->participants)
+			{
+				if (participant.IsValid())
+				{
+					validParticipants.Add(participant.ToScriptInterface());
+				}
+			}
+		}
+		return validParticipants;
+	}
+
+	int32 Num() const { return trees.Num(); }
+
+private:
+
+	TMap<int64, FContextTreeEntry> trees;
+};
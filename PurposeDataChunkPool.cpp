@@ -0,0 +1,99 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+
+#include "Purpose/PurposeDataChunkPool.h"
+#include "GlobalLog.h"
+#include "Purpose/PurposeEvaluationThread.h"
+
+UDataChunk* FDataChunkPool::Acquire(TSubclassOf<UDataChunk> chunkClass)
+{
+	check(IsInGameThread());
+
+	if (!chunkClass || !owner.IsValid())
+	{
+		Global::LogError(PURPOSE, "FDataChunkPool", "Acquire", TEXT("Attempting to acquire %s from a pool %s!")
+			, chunkClass ? *chunkClass->GetName() : TEXT("an invalid class")
+			, owner.IsValid() ? TEXT("") : TEXT("without an owner")
+		);
+		return nullptr;
+	}
+
+	UDataChunk* chunk = nullptr;
+	FDataChunkPoolBucket* bucket = buckets.Find(chunkClass.Get());
+	if (bucket && bucket->freeChunks.Num() == 0)
+	{
+		RecycleCooledChunks(*bucket);
+	}
+
+	if (bucket && bucket->freeChunks.Num() > 0)
+	{
+		++hits;
+		chunk = bucket->freeChunks.Pop(false);
+		chunk->ReinitializeProperties();/// Back to the class defaults, as though newly created
+	}
+	else
+	{
+		++misses;
+		chunk = NewObject<UDataChunk>(owner.Get(), chunkClass);
+	}
+
+	handedOut.Add(chunk);
+	return chunk;
+}
+
+void FDataChunkPool::Release(UDataChunk* chunk)
+{
+	check(IsInGameThread());
+
+	if (!IsValid(chunk) || !handedOut.Contains(chunk))
+	{
+		return;/// Not one of ours, such as a chunk created by the owner itself
+	}
+
+	/// Replacing a chunk with itself leaves it held
+	IDataMapInterface* dataMap = Cast<IDataMapInterface>(owner.Get());
+	if (dataMap && dataMap->HasData(chunk->GetClass()) && dataMap->DataChunk(chunk->GetClass()) == chunk)
+	{
+		return;
+	}
+
+	handedOut.Remove(chunk);
+
+	FDataChunkPoolBucket& bucket = buckets.FindOrAdd(chunk->GetClass());
+	if (bucket.freeChunks.Num() + bucket.coolingChunks.Num() >= maxChunksPerClass)
+	{
+		return;/// Left to GC
+	}
+
+	const FPurposeBlackboard* worldState = WorldState();
+	bucket.coolingChunks.Add(chunk);
+	bucket.publishReleased.Add(worldState ? worldState->NumPublished() : 0);
+}
+
+void FDataChunkPool::RecycleCooledChunks(FDataChunkPoolBucket& bucket)
+{
+	FPurposeBlackboard* worldState = WorldState();
+	const uint64 oldestLivePublish = worldState ? worldState->OldestLivePublish() : MAX_uint64;/// Without a blackboard no thread reads our data map
+
+	/// Chunks are released in publish order, so everything before the first chunk still readable is ready
+	int32 numCooled = 0;
+	while (numCooled < bucket.publishReleased.Num() && bucket.publishReleased[numCooled] < oldestLivePublish)
+	{
+		++numCooled;
+	}
+
+	if (numCooled == 0)
+	{
+		return;
+	}
+
+	bucket.freeChunks.Append(bucket.coolingChunks.GetData(), numCooled);
+	bucket.coolingChunks.RemoveAt(0, numCooled, false);
+	bucket.publishReleased.RemoveAt(0, numCooled, false);
+}
+
+FPurposeBlackboard* FDataChunkPool::WorldState() const
+{
+	IPurposeManagementInterface* purposeOwner = Cast<IPurposeManagementInterface>(owner.Get());
+	return purposeOwner && IsValid(purposeOwner->GetHeadOfPurposeManagment().GetObject()) ? purposeOwner->GetWorldStateBlackboard() : nullptr;
+}
@@ -0,0 +1,79 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data.h"
+#include "PurposeDataChunkPool.generated.h"
+
+class FPurposeBlackboard;
+
+USTRUCT()
+/// Every chunk of a single class held by FDataChunkPool
+struct FDataChunkPoolBucket
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY()
+	/// Ready to be handed out by Acquire
+	TArray<TObjectPtr<UDataChunk>> freeChunks;
+
+	UPROPERTY()
+	/// Released chunks wait here until no blackboard snapshot they may have been published in is still held, see FPurposeBlackboard::OldestLivePublish
+	TArray<TObjectPtr<UDataChunk>> coolingChunks;
+
+	/// Parallel to coolingChunks, the latest publish of the blackboard when each was released
+	TArray<uint64> publishReleased;
+};
+
+USTRUCT()
+/// <summary>
+/// Recycles the short lived data chunks created by data adjustments rather than leaving them to GC
+/// Each purpose owner holds its own pool, see IPurposeManagementInterface::GetDataChunkPool, so a chunk is outered to its holder for its whole life and is never renamed between outers
+/// Only chunks handed out by Acquire are ever recycled, and are left to GC along with the owner once it ends play
+/// Game thread only
+/// </summary>
+struct FDataChunkPool
+{
+	GENERATED_BODY()
+public:
+
+	/// @param inOwner: Outers every chunk of the pool, and holds them in its data map. Must implement IDataMapInterface
+	void Initialize(UObject* inOwner) { owner = inOwner; }
+
+	/// @return UDataChunk*: A chunk of chunkClass outered to the owner and reset to its defaults, either recycled or newly created
+	UDataChunk* Acquire(TSubclassOf<UDataChunk> chunkClass);
+
+	template<class DataChunkClass>
+	DataChunkClass* Acquire() { return Cast<DataChunkClass>(Acquire(DataChunkClass::StaticClass())); }
+
+	/// Returns a single chunk once the owner has removed or replaced it in its data map
+	/// Does nothing for chunks this pool never handed out, or which the owner still holds
+	void Release(UDataChunk* chunk);
+
+	int32 Hits() const { return hits; }
+	int32 Misses() const { return misses; }
+
+	/// Any chunks released beyond this per class are simply left to GC
+	int32 maxChunksPerClass = 64;
+
+private:
+
+	/// Moves every chunk of the bucket which no thread may still read to its free chunks
+	void RecycleCooledChunks(FDataChunkPoolBucket& bucket);
+
+	/// The blackboard publishing the owner's data map, whose snapshots may hold released chunks
+	FPurposeBlackboard* WorldState() const;
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FDataChunkPoolBucket> buckets;
+
+	/// Every chunk handed out and not yet released
+	TSet<TObjectKey<UDataChunk>> handedOut;
+
+	TWeakObjectPtr<UObject> owner;
+
+	int32 hits = 0;
+	int32 misses = 0;
+};
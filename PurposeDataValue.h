@@ -0,0 +1,112 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data.h"
+#include "PurposeDataValue.generated.h"
+
+USTRUCT(BlueprintType)
+/// <summary>
+/// A value-type stand in for a UDataChunk whose data is nothing more than a number or a class, such as UActorAction, UMorale or UMass
+/// Stored inline within FInlineDataMap so reading it never allocates or dereferences a UObject
+/// UDataChunk remains the choice for anything more complex
+/// </summary>
+struct FDataValue
+{
+	GENERATED_BODY()
+public:
+
+	FDataValue() {}
+
+	FDataValue(TSubclassOf<UDataChunk> inKey, double inNumericValue)
+		: key(inKey)
+		, numericValue(inNumericValue)
+	{}
+
+	FDataValue(TSubclassOf<UDataChunk> inKey, UClass* inClassValue)
+		: key(inKey)
+		, classValue(inClassValue)
+	{}
+
+	UPROPERTY(EditAnywhere)
+	/// The chunk class this value stands in for, so lookups remain consistent with those of FDataMapEntry
+	TSubclassOf<UDataChunk> key = nullptr;
+
+	UPROPERTY(EditAnywhere)
+	/// Floats, integers and enums alike are stored here
+	double numericValue = 0;
+
+	UPROPERTY(EditAnywhere)
+	/// For chunks whose value is a type, such as the ability class of UActorAction
+	TObjectPtr<UClass> classValue = nullptr;
+
+	FORCEINLINE bool operator ==(const FDataValue& other) const
+	{
+		return key == other.key && numericValue == other.numericValue && classValue == other.classValue;
+	}
+};
+
+USTRUCT(BlueprintType)
+/// <summary>
+/// The inline counterpart to a TArray<FDataMapEntry>, holding at most one FDataValue per chunk class
+/// </summary>
+struct FInlineDataMap
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(EditAnywhere)
+	/// Maps rarely hold more than a handful of values, so a linear search beats hashing here
+	TArray<FDataValue> values;
+
+	const FDataValue* Find(const UClass* inKey) const
+	{
+		return values.FindByPredicate([inKey](const FDataValue& value) { return value.key == inKey; });
+	}
+
+	bool HasValue(const UClass* inKey) const { return Find(inKey) != nullptr; }
+
+	/// @return double: The numeric value stored for inKey, otherwise defaultValue
+	double NumericValue(const UClass* inKey, const double defaultValue = 0) const
+	{
+		const FDataValue* value = Find(inKey);
+		return value ? value->numericValue : defaultValue;
+	}
+
+	/// @return UClass*: The class value stored for inKey, otherwise nullptr
+	UClass* ClassValue(const UClass* inKey) const
+	{
+		const FDataValue* value = Find(inKey);
+		return value ? value->classValue.Get() : nullptr;
+	}
+
+	/// Overwrites any value already stored for the same key
+	void SetValue(const FDataValue& inValue)
+	{
+		if (FDataValue* existing = values.FindByPredicate([&inValue](const FDataValue& value) { return value.key == inValue.key; }))
+		{
+			*existing = inValue;
+			return;
+		}
+		values.Add(inValue);
+	}
+
+	bool RemoveValue(const UClass* inKey)
+	{
+		return values.RemoveAllSwap([inKey](const FDataValue& value) { return value.key == inKey; }) > 0;
+	}
+
+	void Append(const FInlineDataMap& other, bool overwriteValue = true)
+	{
+		for (const FDataValue& value : other.values)
+		{
+			if (overwriteValue || !HasValue(value.key))
+			{
+				SetValue(value);
+			}
+		}
+	}
+
+	int32 Num() const { return values.Num(); }
+};
@@ -11,9 +11,16 @@
 #include "Curves/CurveFloat.h"
 #include "Purpose/PurposeAbilityComponent.h"
 #include "Purpose/Abilities/GA_PurposeBase.h"
+#include "Purpose/PurposeEventRegistry.h"
 
 #pragma region PurposeEvaluationThread
 
+thread_local const FInlineDataMap* FPurposeEvaluationThread::contextValuesUnderEvaluation = nullptr;
+
+std::atomic<int64> FContextIDAllocator::nextBlock(1);
+thread_local int64 FContextIDAllocator::nextInBlock = 0;
+thread_local int64 FContextIDAllocator::endOfBlock = 0;
+
 bool FPurposeEvaluationThread::Init()
 {
 	//Global::Log(FULLTRACE, PURPOSE, "FPurposeEvaluationThread", "Init", TEXT(""));
@@ -36,10 +43,14 @@ bool FPurposeEvaluationThread::SelectPurposeIfPossible(FPotentialPurposes& purpo
 	/// The FPotentialPurposes is created to represent 1 single candidate (the purpose owner of the FPotentialPurposes)
 		/// with any number of entries of uniquesubjects that are a combination of that candidate and other subjects desired by the purpose owner who created this FPotentialPurposes
 	float highScore = 0;
-	int highScorePurposeIndex = -1;
-	FPurposeAddress highScorePurposeAddress;
-	FSubjectMap highScoreSubjectCombination;
-	FPurpose highScorePurpose;
+
+	/// Hold the front buffer for the duration of this evaluation, so every combination is scored against the same world state
+	FPurposeBlackboardSnapshotPtr worldState = blackboard ? blackboard->Front() : nullptr;
+
+	/// Every condition evaluated below shares the context of purposeToEvaluate
+	TGuardValue<const FInlineDataMap*> contextValuesGuard(contextValuesUnderEvaluation, &purposeToEvaluate.ContextValues());
+	const FPotentialPurposeEntry* highScoreEntry = nullptr;
+	const FSubjectMap* highScoreSubjectCombination = nullptr;
 
 	for (FPotentialPurposeEntry& purpose : purposeToEvaluate.potentialPurposes)
 	{
@@ -48,134 +59,25 @@ bool FPurposeEvaluationThread::SelectPurposeIfPossible(FPotentialPurposes& purpo
 		for (FSubjectMap& subjectCombination : purpose.mapOfUniqueSubjectEntriesForPurpose)
 		{
 			/// Firstly we need to combine the subject map of the context with the unique subject entry to present evaluation a single subject map to pull from
-			subjectCombination.subjects.Append(purposeToEvaluate.staticSubjectMapForPotentialPurposes.subjects);
+			subjectCombination.Append(purposeToEvaluate.StaticSubjectMap());
 
 			/// Now that we have a single subject map, we can score it against each potential purpose in order to find the best purpose for each combination
 			/// The end result desired is to have the best purpose for the best combination of the unique subject
-			const FPurpose& potentialPurpose = purpose.purposeToBeEvaluated;
-
-			/// Design: Purpose Evaluation Log; Solve how to provide the log with a category for each purpose layer
-				/// Perhaps it'll need to come from purposeOwner?
-				/// Can use the TMap<uint8, TQueue> as to determine which layer we're at
-			Global::Log(DATADEBUG, PURPOSE, "FPurposeEvaluationThread", "SelectPurposeIfPossible", TEXT("Purpose: %s")
-				, *potentialPurpose.descriptionOfPurpose
-			);
-			/// Potential score is used to determine whether this purpose will remain above the minimum score of previous purposes
-			/// Potential score equals +1 for each condition + an exponential decay additional
-			/// More conditions then give purposes a slight advantage that decays so that it doesn't stifle competition against other purposes with less conditions
-			float potentialScore = 0.0f;
-			///Total weight is used to adjust a condition's score by condition->weight / totalWeight
-			///This is so that conditions can be given a user selected weight without having to recalculate other condition->weight for each adjustment
-			float totalWeight = 0.0f;
-
-			potentialPurpose.Potential(potentialScore, totalWeight);
-
-			const int totalConditions = potentialPurpose.GetConditions().Num();
-
-			/// the potential score for each condition increases with the number of conditions
-			/// when we divide that total potential score by the total number of conditions we get a potential score for each condition
-			/// So with 3 conditions, the potential score of each individual is higher than when just 1 condition
-			const float individualPotentialScore = potentialScore / totalConditions;
-
-			/// ConditionDetractor is the difference between how much a condition could score and how much it actually scores
-			/// By continually adding that difference to a single variable, we can test whether potentialScore - conditionDetractor < min (or the current highest score)
-			float conditionDetractor = 0.0f;
-
-			float finalScore = 0.0f;
-			Global::Log(DATADEBUG, PURPOSE, "FPurposeEvaluationThread", "SelectPurposeIfPossible", TEXT("Scoring: %s For Candidate: %s. Context Chain: %s, Number Conditions: %d.")
-				, *potentialPurpose.descriptionOfPurpose
-				, subjectCombination.subjects.Contains(ESubject::Candidate) ? *subjectCombination.subjects[ESubject::Candidate].GetObject()->GetFullGroupName(false) : TEXT("Invalid")
-				, *purposeToEvaluate.DescriptionOfParentPurpose
-				, totalConditions
-			);
-
-			/// Now that we are ready to evaluate for the conditions, we will need to comine the data of the context with the data of the subjects
-			/// While this will make each data chunk a copy rather than the exact current data from a pointer, the differences in time between occurrence and evaluation should be milliseconds
-			/// It's a minimal price to pay for the new structure of purpose, where we no longer have to manually root/unroot object pointers for background threads
-			TMap<ESubject, TArray<FDataMapEntry>> subjectMapForCondition = subjectCombination.GetSubjectsAsDataMaps();
-			subjectMapForCondition.Add(ESubject::Context, purposeToEvaluate.ContextDataForPotentialPurposes);
-
-			for (const TObjectPtr<UCondition> condition : potentialPurpose.GetConditions())
+			if (!purpose.purposeToBeEvaluated)
 			{
-				if ((potentialScore - conditionDetractor) < highScore)///Potential score adjusted by actual condition scores must remain above min
-				{
-					Global::Log(DATATRIVIAL, PURPOSE, "FPurposeEvaluationThread", "SelectPurposeIfPossible", TEXT("PotentialScore of %s less than min."), *condition->description.ToString());
-					finalScore = 0.0f;
-					break;
-				}
-
-				if (!IsValid(condition))
-				{
-					Global::Log(DATATRIVIAL, PURPOSE, "FPurposeEvaluationThread", "SelectPurposeIfPossible", TEXT("Purpose->conditions returned an invalid object."));
-					conditionDetractor += individualPotentialScore;///Ensure that if this condition can't evaluate it counts against purpose
-					continue;
-				}
-
-				float score = condition->EvaluateCondition(subjectMapForCondition, purposeToEvaluate.purposeOwner, purposeToEvaluate.uniqueIdentifierOfParent, purposeToEvaluate.addressOfParentPurpose);///Get a baseline score for condition
-
-				if (score <= 0 && condition->isRequired)
-				{
-					finalScore = 0.0f;
-					break;
-				}
-
-				float curveScore = condition->AdjustToCurve(score);///Adjust score to fit along a curve if present
-
-				/// If we multiply the score adjusted to the curve by the individualPotentialScore
-				/// We provide an adjustment to score that results in purposes with more conditions having a slightly higher score potential
-				/// This is to mitigate the higher risk of low value conditions and reward complexity of purpose scoring
-				float curveScoreAdjusteByIndividualPotential = curveScore * individualPotentialScore;
-
-				/// When we divide the current weight of the condition by the total weight and multiply the score by that, 
-				/// We are actually normalizing the the entire purpose's score to its maxpotentialscore / totalweight
-				/// While allowing each condition to make up a larger bulk of that score
-				float adjustConditionScore = curveScoreAdjusteByIndividualPotential * (condition->weight / totalWeight);
-
-				/// Get the difference between it's potential score by its curve adjusted score (both including weight of condition)
-				conditionDetractor += (individualPotentialScore * (condition->weight / totalWeight)) - adjustConditionScore;///if curveScore is < 1, then conditionDetractor will increase
-
-				/// Scores are normalized to their max, so we just add them up for the final score
-				finalScore += adjustConditionScore;
-				Global::Log(DATATRIVIAL, PURPOSE, "FPurposeEvaluationThread", "SelectPurposeIfPossible", TEXT("Original Score for %s: %f; CurveScore: %f. IndividualPotential: %f. TotalPotential = %f. CurveScoreAdjustedByPotential: %f. Condition->Weight: %f. TotalWeight: %f. TotalDeductionFromPurposeScore: %f. AdjustedConditionScore: %f. Final Score: %f")
-					, *condition->description.ToString()
-					, score
-					, curveScore
-					, individualPotentialScore
-					, potentialScore
-					, curveScoreAdjusteByIndividualPotential
-					, condition->weight
-					, totalWeight
-					, conditionDetractor
-					, adjustConditionScore
-					, finalScore
-				);
-
-				Global::Log(DATADEBUG, PURPOSE, "FPurposeEvaluationThread", "SelectPurposeIfPossible", TEXT("Score for Condition: %s = %f; Potential Score = %f."), *condition->description.ToString(), finalScore, potentialScore);
+				Global::LogError(PURPOSE, "FPurposeEvaluationThread", "SelectPurposeIfPossible", TEXT("Potential purpose at %s beneath %s is invalid!"), *purpose.addressOfPurpose.GetAddressAsString(), *purposeToEvaluate.DescriptionOfParentPurpose());
+				break;
 			}
 
-			Global::Log(DATAESSENTIAL, PURPOSE, "FPurposeEvaluationThread", "SelectPurposeIfPossible", TEXT("Candidate %s. Score of %s is %f. Instigator %s. %s.")
-				, subjectCombination.subjects.Contains(ESubject::Candidate) ? *subjectCombination.subjects[ESubject::Candidate].GetObject()->GetFullGroupName(false) : TEXT("Invalid")
-				, *potentialPurpose.descriptionOfPurpose
-				, finalScore
-				, subjectCombination.subjects.Contains(ESubject::Instigator) ? *subjectCombination.subjects[ESubject::Instigator].GetObject()->GetFullGroupName(false) : TEXT("Unknown")
-				, subjectCombination.subjects.Contains(ESubject::ObjectiveTarget) ? *FString::Printf(TEXT("ObjectiveTarget %s"), *subjectCombination.subjects[ESubject::ObjectiveTarget].GetObject()->GetFullGroupName(false))
-				: subjectCombination.subjects.Contains(ESubject::EventTarget) ? *FString::Printf(TEXT("ObjectiveTarget %s"), *subjectCombination.subjects[ESubject::EventTarget].GetObject()->GetFullGroupName(false))
-				: TEXT("Unknown Target")
-			);
-
-			//contextData->ScoreCache = finalScore;/// Ensure the context has a the score stored for future use
-			//return finalScore;
-
+			const float finalScore = ScoreSubjectCombination(purposeToEvaluate, purpose, subjectCombination, worldState.Get(), highScore);
 			if (finalScore > highScore)
 			{
 				/// Ensure new high score is reflected
 				highScore = finalScore;
 
-				highScorePurposeAddress = purpose.addressOfPurpose;
-
 				/// Lastly we store which combination of UniqueSubject + potential purpose scored absolute highest
-				highScoreSubjectCombination = subjectCombination;
-				highScorePurpose = potentialPurpose;
+				highScoreEntry = &purpose;
+				highScoreSubjectCombination = &subjectCombination;
 			}
 		}
 	}
@@ -183,50 +85,336 @@ bool FPurposeEvaluationThread::SelectPurposeIfPossible(FPotentialPurposes& purpo
 	/// if highScore was set, a purpose was found
 	if (highScore > 0)
 	{
-		/// So now we want to pass the purpose back to the owner and game thread
-		FContextData context(
-			highScorePurpose
-			, highScoreSubjectCombination
-			, purposeToEvaluate.ContextDataForPotentialPurposes
-			, purposeToEvaluate.purposeOwner
-			, highScorePurposeAddress
-			, purposeToEvaluate.DescriptionOfParentPurpose /// This is how we create a chain of purpose names for log debugging purposes
-			, purposeToEvaluate.uniqueIdentifierOfParent /// If the FPotentialPurposes had a parent, we need to ensure we pass that ID along to the context
+		PurposeFound(purposeToEvaluate, *highScoreEntry, *highScoreSubjectCombination, highScore);
+		return true;
+	}
+	return false;
+}
+
+float FPurposeEvaluationThread::ScoreSubjectCombination(const FPotentialPurposes& purposeToEvaluate, const FPotentialPurposeEntry& purpose, const FSubjectMap& subjectCombination, const FPurposeBlackboardSnapshot* worldState, const float minimumScore)
+{
+	const FPurpose& potentialPurpose = *purpose.purposeToBeEvaluated;
+
+	/// Design: Purpose Evaluation Log; Solve how to provide the log with a category for each purpose layer
+		/// Perhaps it'll need to come from purposeOwner?
+		/// Can use the TMap<uint8, TQueue> as to determine which layer we're at
+	Global::Log(DATADEBUG, PURPOSE, "FPurposeEvaluationThread", "ScoreSubjectCombination", TEXT("Purpose: %s")
+		, *potentialPurpose.descriptionOfPurpose
+	);
+	/// Potential score is used to determine whether this purpose will remain above the minimum score of previous purposes
+	/// Potential score equals +1 for each condition + an exponential decay additional
+	/// More conditions then give purposes a slight advantage that decays so that it doesn't stifle competition against other purposes with less conditions
+	/// Both never change for a purpose, so are compiled with the purpose tree rather than found for every subject combination
+	const float potentialScore = purpose.potentialScore;
+	///Total weight is used to adjust a condition's score by condition->weight / totalWeight
+	///This is so that conditions can be given a user selected weight without having to recalculate other condition->weight for each adjustment
+	const float totalWeight = purpose.totalWeight;
+
+	const int totalConditions = potentialPurpose.GetConditions().Num();
+
+	/// the potential score for each condition increases with the number of conditions
+	/// when we divide that total potential score by the total number of conditions we get a potential score for each condition
+	/// So with 3 conditions, the potential score of each individual is higher than when just 1 condition
+	const float individualPotentialScore = potentialScore / totalConditions;
+
+	/// ConditionDetractor is the difference between how much a condition could score and how much it actually scores
+	/// By continually adding that difference to a single variable, we can test whether potentialScore - conditionDetractor < min (or the current highest score)
+	float conditionDetractor = 0.0f;
+
+	float finalScore = 0.0f;
+	Global::Log(DATADEBUG, PURPOSE, "FPurposeEvaluationThread", "ScoreSubjectCombination", TEXT("Scoring: %s For Candidate: %s. Parent Context: %lld, Number Conditions: %d.")
+		, *potentialPurpose.descriptionOfPurpose
+		, subjectCombination.subjects.Contains(ESubject::Candidate) ? *subjectCombination.subjects[ESubject::Candidate].GetObject()->GetFullGroupName(false) : TEXT("Invalid")
+		, purposeToEvaluate.uniqueIdentifierOfParent/// Logged per subject combination, so the parent is identified rather than named
+		, totalConditions
+	);
+
+	/// Now that we are ready to evaluate for the conditions, we will need to comine the data of the context with the data of the subjects
+	/// While this will make each data chunk a copy rather than the exact current data from a pointer, the differences in time between occurrence and evaluation should be milliseconds
+	/// It's a minimal price to pay for the new structure of purpose, where we no longer have to manually root/unroot object pointers for background threads
+	TMap<ESubject, TArray<FDataMapEntry>> subjectMapForCondition = subjectCombination.GetSubjectsAsDataMaps(worldState);
+	subjectMapForCondition.Add(ESubject::Context, purposeToEvaluate.ContextData());
+
+	for (const TObjectPtr<UCondition> condition : potentialPurpose.GetConditions())
+	{
+		if ((potentialScore - conditionDetractor) < minimumScore)///Potential score adjusted by actual condition scores must remain above min
+		{
+			Global::Log(DATATRIVIAL, PURPOSE, "FPurposeEvaluationThread", "ScoreSubjectCombination", TEXT("PotentialScore of %s less than min."), *condition->description.ToString());
+			finalScore = 0.0f;
+			break;
+		}
+
+		if (!IsValid(condition))
+		{
+			Global::Log(DATATRIVIAL, PURPOSE, "FPurposeEvaluationThread", "ScoreSubjectCombination", TEXT("Purpose->conditions returned an invalid object."));
+			conditionDetractor += individualPotentialScore;///Ensure that if this condition can't evaluate it counts against purpose
+			continue;
+		}
+
+		float score = condition->EvaluateCondition(subjectMapForCondition, purposeToEvaluate.purposeOwner, purposeToEvaluate.uniqueIdentifierOfParent, purposeToEvaluate.addressOfParentPurpose);///Get a baseline score for condition
+
+		if (score <= 0 && condition->isRequired)
+		{
+			finalScore = 0.0f;
+			break;
+		}
+
+		float curveScore = condition->AdjustToCurve(score);///Adjust score to fit along a curve if present
+
+		/// If we multiply the score adjusted to the curve by the individualPotentialScore
+		/// We provide an adjustment to score that results in purposes with more conditions having a slightly higher score potential
+		/// This is to mitigate the higher risk of low value conditions and reward complexity of purpose scoring
+		float curveScoreAdjusteByIndividualPotential = curveScore * individualPotentialScore;
+
+		/// When we divide the current weight of the condition by the total weight and multiply the score by that, 
+		/// We are actually normalizing the the entire purpose's score to its maxpotentialscore / totalweight
+		/// While allowing each condition to make up a larger bulk of that score
+		float adjustConditionScore = curveScoreAdjusteByIndividualPotential * (condition->weight / totalWeight);
+
+		/// Get the difference between it's potential score by its curve adjusted score (both including weight of condition)
+		conditionDetractor += (individualPotentialScore * (condition->weight / totalWeight)) - adjustConditionScore;///if curveScore is < 1, then conditionDetractor will increase
+
+		/// Scores are normalized to their max, so we just add them up for the final score
+		finalScore += adjustConditionScore;
+		Global::Log(DATATRIVIAL, PURPOSE, "FPurposeEvaluationThread", "ScoreSubjectCombination", TEXT("Original Score for %s: %f; CurveScore: %f. IndividualPotential: %f. TotalPotential = %f. CurveScoreAdjustedByPotential: %f. Condition->Weight: %f. TotalWeight: %f. TotalDeductionFromPurposeScore: %f. AdjustedConditionScore: %f. Final Score: %f")
+			, *condition->description.ToString()
+			, score
+			, curveScore
+			, individualPotentialScore
+			, potentialScore
+			, curveScoreAdjusteByIndividualPotential
+			, condition->weight
+			, totalWeight
+			, conditionDetractor
+			, adjustConditionScore
+			, finalScore
 		);
-		
-		context.cachedScoreOfPurpose = highScore;
-
-		/// We want to check if this potential purpose is already an active purpose
-		/// We allow purposes to evaluate prior to a similarity check so as not to affect the scoring process
-		/// If we immediately eliminated similar purposes before scoring, we may allow a lesser purpose to be selected when it wouldn't have been
-		bool bPurposeAlreadyActive = false;
-		int64 IDofActiveContext = 0;
-		for (const FContextData& activeContext : purposeToEvaluate.purposeOwner->GetActivePurposes())
+
+		Global::Log(DATADEBUG, PURPOSE, "FPurposeEvaluationThread", "ScoreSubjectCombination", TEXT("Score for Condition: %s = %f; Potential Score = %f."), *condition->description.ToString(), finalScore, potentialScore);
+	}
+
+	Global::Log(DATAESSENTIAL, PURPOSE, "FPurposeEvaluationThread", "ScoreSubjectCombination", TEXT("Candidate %s. Score of %s is %f. Instigator %s. %s.")
+		, subjectCombination.subjects.Contains(ESubject::Candidate) ? *subjectCombination.subjects[ESubject::Candidate].GetObject()->GetFullGroupName(false) : TEXT("Invalid")
+		, *potentialPurpose.descriptionOfPurpose
+		, finalScore
+		, subjectCombination.subjects.Contains(ESubject::Instigator) ? *subjectCombination.subjects[ESubject::Instigator].GetObject()->GetFullGroupName(false) : TEXT("Unknown")
+		, subjectCombination.subjects.Contains(ESubject::ObjectiveTarget) ? *FString::Printf(TEXT("ObjectiveTarget %s"), *subjectCombination.subjects[ESubject::ObjectiveTarget].GetObject()->GetFullGroupName(false))
+		: subjectCombination.subjects.Contains(ESubject::EventTarget) ? *FString::Printf(TEXT("ObjectiveTarget %s"), *subjectCombination.subjects[ESubject::EventTarget].GetObject()->GetFullGroupName(false))
+		: TEXT("Unknown Target")
+	);
+
+	return finalScore;
+}
+
+void FPurposeEvaluationThread::PurposeFound(const FPotentialPurposes& purposeToEvaluate, const FPotentialPurposeEntry& purpose, const FSubjectMap& subjectCombination, const float score, const bool bAssignedJointly)
+{
+	const FPurpose& purposeFound = *purpose.purposeToBeEvaluated;
+	const FPurposeAddress& addressOfPurposeFound = purpose.addressOfPurpose;
+
+	/// So now we want to pass the purpose back to the owner and game thread
+	FContextData context(
+		&purposeFound/// Referenced rather than copied, the context holds the tree it was evaluated from
+		, purposeToEvaluate.purposeTree
+		, subjectCombination
+		, purposeToEvaluate.ContextData()
+		, purposeToEvaluate.purposeOwner
+		, addressOfPurposeFound
+		, purposeToEvaluate.uniqueIdentifierOfParent /// If the FPotentialPurposes had a parent, we need to ensure we pass that ID along to the context
+	);
+	
+	context.cachedScoreOfPurpose = score;
+	context.bAssignedJointly = bAssignedJointly;
+	context.contextValues = purposeToEvaluate.ContextValues();
+
+	/// We want to check if this potential purpose is already an active purpose
+	/// We allow purposes to evaluate prior to a similarity check so as not to affect the scoring process
+	/// If we immediately eliminated similar purposes before scoring, we may allow a lesser purpose to be selected when it wouldn't have been
+	bool bPurposeAlreadyActive = false;
+	int64 IDofActiveContext = 0;
+	for (const FContextData& activeContext : purposeToEvaluate.purposeOwner->GetActivePurposes())
+	{
+		bPurposeAlreadyActive = purposeToEvaluate.purposeOwner->DoesPurposeAlreadyExist(activeContext, context.subjectMap, context.contextData, context.contextValues, context.addressOfPurpose);
+
+		if (bPurposeAlreadyActive) 
+		{ 
+			IDofActiveContext = activeContext.GetContextID();
+			break; 
+		}
+	}
+
+	!bPurposeAlreadyActive ? CreateAsyncTask_PurposeSelected(MoveTemp(context)) : CreateAsyncTask_ReOccurrence(context.purposeOwner, context.addressOfPurpose, IDofActiveContext);
+}
+
+bool FPurposeEvaluationThread::SelectJointPurposesIfPossible(FJointPotentialPurposes& jointPurposes)
+{
+	/// Hold the front buffer for the duration of this evaluation, so every candidate is scored against the same world state
+	FPurposeBlackboardSnapshotPtr worldState = blackboard ? blackboard->Front() : nullptr;
+
+	/// Every candidate shares the parent context, so its values are the same for each
+	const FInlineDataMap* contextValues = jointPurposes.candidates.Num() > 0 ? &jointPurposes.candidates[0].ContextValues() : nullptr;
+	TGuardValue<const FInlineDataMap*> contextValuesGuard(contextValuesUnderEvaluation, contextValues);
+
+	/// Unlike SelectPurposeIfPossible, every combination is scored in full, as a candidate's best purpose may be full and its next best is then needed
+	TArray<FJointScore> scores;
+	for (int32 candidateIndex = 0; candidateIndex < jointPurposes.candidates.Num(); ++candidateIndex)
+	{
+		FPotentialPurposes& candidate = jointPurposes.candidates[candidateIndex];
+		for (int32 entryIndex = 0; entryIndex < candidate.potentialPurposes.Num(); ++entryIndex)
 		{
-			bPurposeAlreadyActive = purposeToEvaluate.purposeOwner->DoesPurposeAlreadyExist(activeContext, context.subjectMap, context.contextData, context.addressOfPurpose);
+			FPotentialPurposeEntry& purpose = candidate.potentialPurposes[entryIndex];
+			if (!purpose.purposeToBeEvaluated)
+			{
+				Global::LogError(PURPOSE, "FPurposeEvaluationThread", "SelectJointPurposesIfPossible", TEXT("Potential purpose at %s beneath %s is invalid!"), *purpose.addressOfPurpose.GetAddressAsString(), *candidate.DescriptionOfParentPurpose());
+				continue;
+			}
 
-			if (bPurposeAlreadyActive) 
-			{ 
-				IDofActiveContext = context.GetContextID();
-				break; 
+			for (int32 combinationIndex = 0; combinationIndex < purpose.mapOfUniqueSubjectEntriesForPurpose.Num(); ++combinationIndex)
+			{
+				FSubjectMap& subjectCombination = purpose.mapOfUniqueSubjectEntriesForPurpose[combinationIndex];
+				subjectCombination.Append(candidate.StaticSubjectMap());
+
+				const float score = ScoreSubjectCombination(candidate, purpose, subjectCombination, worldState.Get(), 0.0f);
+				if (score > 0.0f)
+				{
+					scores.Add(FJointScore{ score, candidateIndex, entryIndex, combinationIndex });
+				}
 			}
 		}
+	}
 
-		!bPurposeAlreadyActive ? CreateAsyncTask_PurposeSelected(context) : CreateAsyncTask_ReOccurrence(context.purposeOwner, context.addressOfPurpose, IDofActiveContext);
-		return true;
+	/// Greedily hand each candidate its best remaining purpose, highest scores first, until the purpose is full
+	scores.Sort([](const FJointScore& a, const FJointScore& b) { return a.score > b.score; });
+
+	TBitArray<> assigned(false, jointPurposes.candidates.Num());
+	TMap<int32, int32> remainingCapacity = jointPurposes.capacityOfSubPurpose;
+	int32 numAssigned = 0;
+	for (const FJointScore& score : scores)
+	{
+		if (assigned[score.candidateIndex])
+		{
+			continue;
+		}
+
+		const FPotentialPurposes& candidate = jointPurposes.candidates[score.candidateIndex];
+		const FPotentialPurposeEntry& purpose = candidate.potentialPurposes[score.entryIndex];
+		const int32 subPurposeIndex = purpose.addressOfPurpose.GetAddressOfThisPurpose();
+		const int32* heldIndex = jointPurposes.heldSubPurposeOfCandidate.Find(candidate.purposeOwner.GetObject());
+
+		/// A candidate staying within the sub purpose it holds already counts toward its participants
+		if (!heldIndex || *heldIndex != subPurposeIndex)
+		{
+			int32* capacity = remainingCapacity.Find(subPurposeIndex);/// Purposes without a capacity are unlimited
+			if (capacity)
+			{
+				if (*capacity <= 0)
+				{
+					continue;
+				}
+				--*capacity;
+			}
+
+			if (int32* freedCapacity = heldIndex ? remainingCapacity.Find(*heldIndex) : nullptr)
+			{
+				++*freedCapacity;/// The candidate has now moved, so its previous place may be taken
+			}
+		}
+
+		assigned[score.candidateIndex] = true;
+		++numAssigned;
+		PurposeFound(candidate, purpose, purpose.mapOfUniqueSubjectEntriesForPurpose[score.combinationIndex], score.score, true);
+
+		if (numAssigned == jointPurposes.candidates.Num())
+		{
+			break;
+		}
 	}
-	return false;
+
+	Global::Log(DATADEBUG, PURPOSE, "FPurposeEvaluationThread", "SelectJointPurposesIfPossible", TEXT("Assigned %d of %d candidates from %d scored combinations. Parent Context: %lld.")
+		, numAssigned
+		, jointPurposes.candidates.Num()
+		, scores.Num()
+		, jointPurposes.candidates.Num() > 0 ? jointPurposes.candidates[0].uniqueIdentifierOfParent : 0
+	);
+	return numAssigned > 0;
+}
+
+bool FPurposeEvaluationThread::EvaluateNextJointPurposes()
+{
+	FJointPotentialPurposes jointPurposes;
+	if (!jointPurposeQueue.Dequeue(jointPurposes))
+	{
+		return false;
+	}
+
+	SelectJointPurposesIfPossible(jointPurposes);
+	return true;
+}
+
+bool FPurposeEvaluationThread::CreateAsyncTask_PurposeSelected(FContextData&& context)
+{
+	TGraphTask<FAsyncGraphTask_PurposeSelected>::CreateTask().ConstructAndDispatchWhenReady(MoveTemp(context));
+	return true;
+}
+
+bool FPurposeEvaluationThread::EvaluateNextCompletionCheck()
+{
+	FCompletionCheck check;
+	if (!completionChecks.Dequeue(check))
+	{
+		return false;
+	}
+
+	const FContextData& context = check.context;
+	const TArray<TObjectPtr<UCondition>>& completionCriteria = context.Purpose().completionCriteria;
+
+	EPurposeState status = EPurposeState::Ongoing;/// Without conditions we have no way of gauging the state of an Objective
+	if (completionCriteria.Num() > 0)
+	{
+		/// Every criterion is scored against the same world state and the same copy of the subjects' data, just as the conditions of a purpose are in SelectPurposeIfPossible
+		FPurposeBlackboardSnapshotPtr worldState = blackboard ? blackboard->Front() : nullptr;
+		TGuardValue<const FInlineDataMap*> contextValuesGuard(contextValuesUnderEvaluation, &context.contextValues);
+
+		TMap<ESubject, TArray<FDataMapEntry>> subjectMapForCondition = context.subjectMap.GetSubjectsAsDataMaps(worldState.Get());
+		subjectMapForCondition.Add(ESubject::Context, context.contextData);
+
+		/// Scoring for completion criteria is meant to be yes/no, the average must be 1, so the first criterion short of 1 decides
+		status = EPurposeState::Complete;
+		for (const TObjectPtr<UCondition> condition : completionCriteria)
+		{
+			if (!IsValid(condition))
+			{
+				Global::LogError(OBJECTIVE, "FPurposeEvaluationThread", "EvaluateNextCompletionCheck", TEXT("completionCriteria of %s returned an invalid object."), *context.GetName());
+				status = EPurposeState::Ongoing;
+				break;
+			}
+
+			if (condition->EvaluateCondition(subjectMapForCondition, context.purposeOwner, context.GetContextID(), context.addressOfPurpose) < 1.0f)
+			{
+				status = EPurposeState::Ongoing;
+				break;
+			}
+		}
+	}
+
+	Global::Log(DATADEBUG, OBJECTIVE, "FPurposeEvaluationThread", "EvaluateNextCompletionCheck", TEXT("Context: %lld, Address: %s, Status: %s.")
+		, context.GetContextID()
+		, *context.addressOfPurpose.GetAddressAsString()
+		, *Global::EnumValueOnly<EPurposeState>(status)
+	);
+
+	CreateAsyncTask_CompletionEvaluated(check.requester, context.GetContextID(), context.addressOfPurpose, status);
+	return true;
 }
 
-bool FPurposeEvaluationThread::CreateAsyncTask_PurposeSelected(FContextData& context)
+bool FPurposeEvaluationThread::CreateAsyncTask_CompletionEvaluated(TScriptInterface<IPurposeManagementInterface> requester, const int64 uniqueContextID, const FPurposeAddress addressOfPurpose, const EPurposeState status)
 {
-	TGraphTask<FAsyncGraphTask_PurposeSelected>::CreateTask().ConstructAndDispatchWhenReady(context);
+	TGraphTask<FAsyncGraphTask_CompletionEvaluated>::CreateTask().ConstructAndDispatchWhenReady(requester, uniqueContextID, addressOfPurpose, status);
 	return true;
 }
 
 bool FPurposeEvaluationThread::CreateAsyncTask_ReOccurrence(TScriptInterface<IPurposeManagementInterface> owner, const FPurposeAddress addressOfPurpose, const int64 outUniqueIDofActivePurpose)
 {
-	TGraphTask<FAsyncGraphTask_ReOccurrence>::CreateTask().ConstructAndDispatchWhenReady(addressOfPurpose, outUniqueIDofActivePurpose);
+	TGraphTask<FAsyncGraphTask_ReOccurrence>::CreateTask().ConstructAndDispatchWhenReady(owner, addressOfPurpose, outUniqueIDofActivePurpose);
 	return true;
 }
 
@@ -251,6 +439,9 @@ uint32 FEventThread::Run()
 			/// Then instead of having to specify which layer in each thread, it's dictated by the order the keys are added when the map is setup
 			///auto itr = potentialPurposeQueues.CreateIterator();
 
+		EvaluateNextCompletionCheck();
+		EvaluateNextJointPurposes();
+
 		FPotentialPurposes purposeToEvaluate(FPurposeAddress(), 0);
 		if (DequeuePurpose((uint8)EPurposeLayer::Objective, purposeToEvaluate))
 		{
@@ -331,6 +522,9 @@ uint32 FCompanionThread::Run()
 	{
 		/// We evaluate in a backwards order, as we want each Event evaluation to be fully resolved by the time the next Event is evaluated
 		
+		EvaluateNextCompletionCheck();
+		EvaluateNextJointPurposes();
+
 		FPotentialPurposes purposeToEvaluate(FPurposeAddress(), 0);
 		if (DequeuePurpose((uint8)EPurposeLayer::Behavior, purposeToEvaluate))
 		{
@@ -363,16 +557,133 @@ void FCompanionThread::Exit()
 
 #pragma endregion
 
+#pragma region PurposeTree
+
+TSharedRef<const FCompiledPurposeTree, ESPMode::ThreadSafe> FCompiledPurposeTree::Compile(TArray<FRegisteredEventPtr> inEvents, TBitArray<> inResidentEvents, const TArray<uint16>& inEventGenerations)
+{
+	TSharedRef<FCompiledPurposeTree, ESPMode::ThreadSafe> tree = MakeShared<FCompiledPurposeTree, ESPMode::ThreadSafe>();
+	tree->events = MoveTemp(inEvents);
+	tree->numEvents = tree->events.Num();
+	auto EventLayer = [&tree](const int32 eventIndex) -> const FEventLayer& { return tree->events[eventIndex]->eventLayer; };
+
+	tree->residentEvents = inResidentEvents.Num() == tree->numEvents ? MoveTemp(inResidentEvents) : TBitArray<>(true, tree->numEvents);
+	tree->numResidentEvents = tree->residentEvents.CountSetBits();
+
+	auto EventAddress = [&inEventGenerations](const int32 eventIndex)
+	{
+		return FPurposeAddress(eventIndex, inEventGenerations.IsValidIndex(eventIndex) ? inEventGenerations[eventIndex] : 0);
+	};
+
+	/// Appends the children of the node at parentIndex as a contiguous span
+	auto AddChildren = [&tree](const int32 parentIndex, auto& children)
+	{
+		tree->nodes[parentIndex].firstChildIndex = tree->nodes.Num();
+		tree->nodes[parentIndex].numChildren = children.Num();
+
+		for (int32 i = 0; i < children.Num(); ++i)
+		{
+			FPurposeTreeNode child;
+			child.purpose = &children[i];
+			child.address = FPurposeAddress(tree->nodes[parentIndex].address, i);/// VERY IMPORTANT, this is how the sub purpose address is established, and is a huge aspect of the PurposeSystem
+			child.parentIndex = parentIndex;
+			tree->nodeIndices.Add(child.address, tree->nodes.Add(child));
+		}
+	};
+
+	for (int32 i = 0; i < tree->numEvents; ++i)
+	{
+		FPurposeTreeNode eventNode;
+		eventNode.purpose = &EventLayer(i);
+		eventNode.address = EventAddress(i);
+		tree->nodeIndices.Add(eventNode.address, tree->nodes.Add(eventNode));
+	}
+
+	/// Breadth first, each layer is appended only once the layer above is complete
+	for (int32 eventIndex = 0; eventIndex < tree->numEvents; ++eventIndex)
+	{
+		AddChildren(eventIndex, EventLayer(eventIndex).goals);
+	}
+
+	const int32 firstGoalIndex = tree->numEvents;
+	const int32 numGoals = tree->nodes.Num() - firstGoalIndex;
+	for (int32 goalIndex = firstGoalIndex; goalIndex < firstGoalIndex + numGoals; ++goalIndex)
+	{
+		AddChildren(goalIndex, static_cast<const FGoalLayer*>(tree->nodes[goalIndex].purpose)->objectives);
+	}
+
+	const int32 firstObjectiveIndex = firstGoalIndex + numGoals;
+	const int32 numObjectives = tree->nodes.Num() - firstObjectiveIndex;
+	for (int32 objectiveIndex = firstObjectiveIndex; objectiveIndex < firstObjectiveIndex + numObjectives; ++objectiveIndex)
+	{
+		AddChildren(objectiveIndex, static_cast<const FObjectiveLayer*>(tree->nodes[objectiveIndex].purpose)->tasks);
+	}
+
+	for (int32 taskIndex = firstObjectiveIndex + numObjectives; taskIndex < tree->nodes.Num(); ++taskIndex)
+	{
+		tree->nodes[taskIndex].behaviorAbility = static_cast<const FTaskLayer*>(tree->nodes[taskIndex].purpose)->behaviorAbility;
+	}
+
+	for (FPurposeTreeNode& node : tree->nodes)
+	{
+		node.purpose->Potential(node.potentialScore, node.totalWeight);
+	}
+
+	return tree;
+}
+
+const FEventLayer* FCompiledPurposeTree::FindEventLayer(const FPurposeAddress& address) const
+{
+	const FPurposeTreeNode* node = address.GetAddressLayer() >= 1 ? FindNode(address.Truncate(1)) : nullptr;
+	return node ? static_cast<const FEventLayer*>(node->purpose) : nullptr;
+}
+
+const FGoalLayer* FCompiledPurposeTree::FindGoalLayer(const FPurposeAddress& address) const
+{
+	const FPurposeTreeNode* node = address.GetAddressLayer() >= 2 ? FindNode(address.Truncate(2)) : nullptr;
+	return node ? static_cast<const FGoalLayer*>(node->purpose) : nullptr;
+}
+
+const FObjectiveLayer* FCompiledPurposeTree::FindObjectiveLayer(const FPurposeAddress& address) const
+{
+	const FPurposeTreeNode* node = address.GetAddressLayer() >= 3 ? FindNode(address.Truncate(3)) : nullptr;
+	return node ? static_cast<const FObjectiveLayer*>(node->purpose) : nullptr;
+}
+
+#pragma endregion
+
+#pragma region ContextData
+
+UDataChunk* FContextData::AcquireDataChunk(TSubclassOf<UDataChunk> chunkClass, UObject* recipient) const
+{
+	IPurposeManagementInterface* recipientOwner = Cast<IPurposeManagementInterface>(recipient);
+	FDataChunkPool* pool = recipientOwner ? recipientOwner->GetDataChunkPool() : nullptr;
+	if (UDataChunk* pooledChunk = pool ? pool->Acquire(chunkClass) : nullptr)
+	{
+		return pooledChunk;
+	}
+	return NewObject<UDataChunk>(recipient, chunkClass);
+}
+
+void FContextData::IncrementDataMapVersionOfSubject(ESubject inSubject) const
+{
+	if (IPurposeManagementInterface* subjectOwner = Cast<IPurposeManagementInterface>(Subject(inSubject)))
+	{
+		subjectOwner->IncrementDataMapVersion();
+	}
+}
+
+#pragma endregion
+
 #pragma region TAsyncGraphTasks
 
 void FAsyncGraphTask_PurposeSelected::PurposeSelected()
 {
 	Global::Log(FULLTRACE, PURPOSE, "FAsyncGraphTask_PurposeSelected", "PurposeSelected", TEXT("Purpose: %s, IsInGameThread: %s")
-		, *contextData.chainedPurposeName
+		, *contextData.GetPurposeChainName()
 		, IsInGameThread() ? TEXT("True") : TEXT("False")
 	);
 
-	PurposeSystem::PurposeSelected(contextData);
+	PurposeSystem::PurposeSelected(MoveTemp(contextData));
 }
 
 void FAsyncGraphTask_ReOccurrence::ReOccurrence()
@@ -381,13 +692,13 @@ void FAsyncGraphTask_ReOccurrence::ReOccurrence()
 		IsInGameThread() ? TEXT("True") : TEXT("False")
 	);
 
-	if (levelDirector.IsValid())
+	if (IPurposeManagementInterface* validOwner = purposeOwner.Get())
 	{
-		levelDirector->ReOccurrenceOfEventObjectives(indexOfEvent);
+		validOwner->PurposeReOccurrence(addressOfPurpose, uniqueIDofActivePurpose);
 	}
 	else
 	{
-		Global::LogError(PURPOSE, "FAsynceGraphTask_ReOccurrence", "ReOccurrence", TEXT("Level Director invalid!"));
+		Global::LogError(PURPOSE, "FAsynceGraphTask_ReOccurrence", "ReOccurrence", TEXT("Purpose owner invalid!"));
 	}
 }
 
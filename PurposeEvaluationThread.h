@@ -9,7 +9,11 @@
 #include "Purpose/Condition.h"
 #include "UObject/Interface.h"
 #include "DataMapInterface.h"
+#include "Purpose/PurposeBlackboard.h"
+#include "Purpose/PurposeDataValue.h"
+#include "Purpose/PurposeDataChunkPool.h"
 #include "Misc/Timespan.h"
+#include <atomic>
 #include "PurposeEvaluationThread.generated.h"
 
 #pragma region PurposeSystem
@@ -143,27 +147,39 @@ USTRUCT(BlueprintType)
 /// For each layer of Purpose, an address layer with the index of that purpose.subPurpose is added.
 /// This works in "Event.Goal.Objective.Behavior" order as we have n number of layers by design
 /// Only the stored Event will have the whole tree of purposes however, so seeking a specific address will have to be requested by whoever stores the Event
-/// This also has to start with a globally relevant Event address. All Events need to be stored in a single location until shutdown, otherwise when one Event ends and is removed the addresses will all be incorrect
+/// This also has to start with a globally relevant Event address, the slot of the Event within FEventRegistry
+/// As slots are reused once an Event unloads, the address also carries the generation of its Event slot, so an address to an unloaded Event never matches its replacement
+/// Each layer is packed into 16 bits of a single uint64, so addresses are built without allocation, compared as integers and safely hashed
 struct FPurposeAddress
 {
 	GENERATED_BODY()
 public:
 
+	/// Event, Goal, Objective and Behavior
+	static constexpr int32 MaxLayers = 4;
+
 	FPurposeAddress() {}
 
 	FPurposeAddress(int inAddress)
-		: address(inAddress)
 	{
-		HierarchicalAddress.Add(address);
+		AddLayer(inAddress);
+	}
+
+	/// @param inGeneration: The generation of the Event slot at inAddress
+	FPurposeAddress(int inAddress, uint16 inGeneration)
+		: generation(inGeneration)
+	{
+		AddLayer(inAddress);
 	}
 
-	FPurposeAddress(FPurposeAddress previousAddress, int inAddress)
-		: address(inAddress)
-		, HierarchicalAddress(previousAddress.HierarchicalAddress)
+	FPurposeAddress(const FPurposeAddress& previousAddress, int inAddress)
+		: packedAddress(previousAddress.packedAddress)
+		, depth(previousAddress.depth)
+		, generation(previousAddress.generation)
 	{
-		/// Firstly we store the previous address to retain the hierarchical structure of purpose layers
+		/// Firstly we copy the previous address to retain the hierarchical structure of purpose layers
 		/// In order to have n layers of purpose, we add to the end until we no longer have a layer
-		HierarchicalAddress.Add(address);
+		AddLayer(inAddress);
 	}
 
 	/// 0 will mean it's at the Event layer
@@ -172,58 +188,231 @@ public:
 	/// 3 is the Behavior layer
 	int GetAddressLayer() const
 	{
-		return HierarchicalAddress.Num();
+		return depth;
 	}
 
 	int GetAddressForLayer(const int& layer) const
 	{
-		return HierarchicalAddress.IsValidIndex(layer) ? HierarchicalAddress[layer] : -1;
+		return layer >= 0 && layer < depth ? UnpackLayer(layer) : -1;
 	}
 
 	int GetAddressOfThisPurpose() const
 	{
-		return address;
+		return depth > 0 ? UnpackLayer(depth - 1) : -1;
 	}
 
 	FString GetAddressAsString() const
 	{
 		FString addressAsString = "";
-		for (int index = 0; index < HierarchicalAddress.Num(); ++index)
+		for (int index = 0; index < depth; ++index)
 		{
-			/// If the index is not at the end of the array of addresses, then add a . to separate them visually
-			addressAsString += FString::Printf(TEXT("%d%s"), HierarchicalAddress[index], index == HierarchicalAddress.Num() - 1 ? "" : ".");
+			/// If the index is not at the end of the address, then add a . to separate them visually
+			addressAsString += FString::Printf(TEXT("%d%s"), UnpackLayer(index), index == depth - 1 ? TEXT("") : TEXT("."));
 		}
 		return addressAsString;
 	}
 
-	inline bool IsValid() const { return address > -1; }
+	inline bool IsValid() const { return GetAddressOfThisPurpose() > -1; }
+
+	/// Every layer of the address as a single integer, layer 0 in the lowest 16 bits
+	uint64 GetPackedAddress() const { return packedAddress; }
+
+	/// The generation of the Event slot this address was built from
+	uint16 GetGeneration() const { return generation; }
+
+	/// @return FPurposeAddress: Only the first numLayers of this address, such as the address of the Event or Goal this purpose belongs to
+	FPurposeAddress Truncate(const int numLayers) const
+	{
+		if (numLayers >= depth)
+		{
+			return *this;
+		}
+
+		FPurposeAddress truncated;
+		if (numLayers > 0)
+		{
+			truncated.depth = numLayers;
+			truncated.packedAddress = packedAddress & ((1ull << (numLayers * 16)) - 1);
+			truncated.generation = generation;
+		}
+		return truncated;
+	}
 
 private:
 
-	int address = -1;
+	/// Stored in place of -1, as each layer is unsigned
+	static constexpr uint16 InvalidLayer = MAX_uint16;
 
-	TArray<int> HierarchicalAddress;
+	uint64 packedAddress = 0;
 
-public:
-	FORCEINLINE bool operator ==(const FPurposeAddress& otherAddress) const
-	{
-		if (otherAddress.address != address) { return false; }
-		if (otherAddress.HierarchicalAddress.Num() != HierarchicalAddress.Num()) { return false; }
+	uint8 depth = 0;
+
+	uint16 generation = 0;
 
-		for (int i = 0; i < HierarchicalAddress.Num(); ++i)
+	void AddLayer(const int inAddress)
+	{
+		if (depth >= MaxLayers)
 		{
-			if (!otherAddress.HierarchicalAddress.IsValidIndex(i)) { return false; }
-			if (HierarchicalAddress[i] != otherAddress.HierarchicalAddress[i]) { return false; }
+			Global::LogError(PURPOSE, "FPurposeAddress", "AddLayer", TEXT("Address %s can not hold more than %d layers!"), *GetAddressAsString(), MaxLayers);
+			return;
 		}
 
-		return true;
+		ensureMsgf(inAddress >= -1 && inAddress < InvalidLayer, TEXT("Purpose index %d does not fit within an address layer"), inAddress);
+		const uint16 layer = inAddress < 0 ? InvalidLayer : (uint16)inAddress;
+		packedAddress |= (uint64)layer << (depth * 16);
+		++depth;
+	}
+
+	int UnpackLayer(const int layer) const
+	{
+		const uint16 packedLayer = (uint16)(packedAddress >> (layer * 16));
+		return packedLayer == InvalidLayer ? -1 : packedLayer;
+	}
+
+public:
+	FORCEINLINE bool operator ==(const FPurposeAddress& otherAddress) const
+	{
+		return packedAddress == otherAddress.packedAddress && depth == otherAddress.depth && generation == otherAddress.generation;
+	}
+
+	FORCEINLINE bool operator !=(const FPurposeAddress& otherAddress) const
+	{
+		return !(*this == otherAddress);
 	}
 };
 FORCEINLINE uint32 GetTypeHash(const FPurposeAddress& b)
 {
-	return FCrc::MemCrc32(&b, sizeof(FPurposeAddress));
+	/// Layers beyond the depth are always 0, so the depth separates 1 from 1.0
+	return HashCombine(GetTypeHash(b.GetPackedAddress()), GetTypeHash(b.GetAddressLayer() | (b.GetGeneration() << 8)));
 }
 
+#pragma region PurposeTree
+
+struct FEventLayer;
+struct FGoalLayer;
+struct FObjectiveLayer;
+struct FRegisteredEvent;
+
+/// Defined alongside FEventRegistry, shared rather than copied into each tree
+typedef TSharedPtr<const FRegisteredEvent, ESPMode::ThreadSafe> FRegisteredEventPtr;
+
+/// A single purpose within FCompiledPurposeTree
+struct FPurposeTreeNode
+{
+	/// Points into the events owned by the tree, so is valid for as long as the tree is held
+	const FPurpose* purpose = nullptr;
+
+	FPurposeAddress address;
+
+	int32 parentIndex = INDEX_NONE;
+
+	/// Siblings are stored contiguously, so the sub purposes of a node are a single span of the node table
+	int32 firstChildIndex = INDEX_NONE;
+	int32 numChildren = 0;
+
+	/// Only set for nodes of the Behavior layer
+	/// Kept alive by the FRegisteredEvent the tree holds, weak so a node copied out of the tree never keeps, nor dangles to, a collected behavior
+	TWeakObjectPtr<class UBehavior_AI> behaviorAbility;
+
+	/// The result of FPurpose::Potential, which never changes once compiled
+	float potentialScore = 0.0f;
+	float totalWeight = 0.0f;
+};
+
+/// <summary>
+/// The event cache compiled into a flat table of nodes, indexed by address
+/// Once compiled it is never modified, so lookups return spans and pointers into the table rather than copies
+/// Whenever the event cache changes a new tree is compiled, anyone still holding the previous one may continue to use it
+/// </summary>
+class FCompiledPurposeTree
+{
+public:
+
+	/// Defined alongside the purpose threads, as the layer types are not complete here
+	/// @param inEvents: The Events of FEventRegistry, only the pointers are copied so compiling never copies an Event
+	/// @param inResidentEvents: One bit per Event, those unset are yet to be loaded and are never provided to occurrences. Empty when every Event is resident
+	/// @param inEventGenerations: The generation of each Event slot, carried by every address beneath it. Empty when every slot is of the first generation
+	static TSharedRef<const FCompiledPurposeTree, ESPMode::ThreadSafe> Compile(TArray<FRegisteredEventPtr> inEvents, TBitArray<> inResidentEvents = TBitArray<>(), const TArray<uint16>& inEventGenerations = TArray<uint16>());
+
+	/// @return const FPurposeTreeNode*: nullptr when no purpose exists at the address
+	const FPurposeTreeNode* FindNode(const FPurposeAddress& address) const
+	{
+		const int32* nodeIndex = nodeIndices.Find(address);
+		return nodeIndex ? &nodes[*nodeIndex] : nullptr;
+	}
+
+	/// The Event layer, ordered by their index within the event cache
+	TArrayView<const FPurposeTreeNode> Events() const
+	{
+		return TArrayView<const FPurposeTreeNode>(nodes.GetData(), numEvents);
+	}
+
+	/// @return TArrayView: The sub purposes of the purpose at address, empty if there are none or the address does not exist
+	TArrayView<const FPurposeTreeNode> ChildrenOf(const FPurposeAddress& address) const
+	{
+		const FPurposeTreeNode* node = FindNode(address);
+		return node ? ChildrenOf(*node) : TArrayView<const FPurposeTreeNode>();
+	}
+
+	TArrayView<const FPurposeTreeNode> ChildrenOf(const FPurposeTreeNode& node) const
+	{
+		return node.numChildren > 0 ? TArrayView<const FPurposeTreeNode>(&nodes[node.firstChildIndex], node.numChildren) : TArrayView<const FPurposeTreeNode>();
+	}
+
+	/// @return const FPurposeTreeNode*: nullptr for Events
+	const FPurposeTreeNode* ParentOf(const FPurposeTreeNode& node) const
+	{
+		return nodes.IsValidIndex(node.parentIndex) ? &nodes[node.parentIndex] : nullptr;
+	}
+
+	int32 NumEvents() const { return numEvents; }
+
+	/// Whether the Event at eventIndex has been loaded, Events yet to be loaded still hold their address but have no sub purposes
+	bool IsEventResident(const int32 eventIndex) const { return residentEvents.IsValidIndex(eventIndex) && residentEvents[eventIndex]; }
+
+	int32 NumResidentEvents() const { return numResidentEvents; }
+
+	int32 NumNodes() const { return nodes.Num(); }
+
+	/// The layers the address belongs to, so an Objective's address will find both its Goal and its Event
+	/// Each is valid for as long as the tree is held, and is never a copy
+	/// @return nullptr when the address does not reach that layer
+	const FEventLayer* FindEventLayer(const FPurposeAddress& address) const;
+	const FGoalLayer* FindGoalLayer(const FPurposeAddress& address) const;
+	const FObjectiveLayer* FindObjectiveLayer(const FPurposeAddress& address) const;
+
+	/// Only for logging, nothing is formatted until called
+	/// @return FString: The description of every purpose from the Event down to address, in the format of "Event::Goal::Objective"
+	FString DescribeChain(const FPurposeAddress& address) const
+	{
+		FString chain;
+		for (const FPurposeTreeNode* node = FindNode(address); node; node = ParentOf(*node))
+		{
+			chain = chain.Len() > 0 ? node->purpose->descriptionOfPurpose + "::" + chain : node->purpose->descriptionOfPurpose;
+		}
+		return chain;
+	}
+
+private:
+
+	/// Every node's purpose points into these, which keep the Events and their UObjects alive for as long as the tree is held
+	TArray<FRegisteredEventPtr> events;
+
+	/// Breadth first, so the Events occupy the first numEvents nodes
+	TArray<FPurposeTreeNode> nodes;
+
+	TMap<FPurposeAddress, int32> nodeIndices;
+
+	int32 numEvents = 0;
+
+	TBitArray<> residentEvents;
+	int32 numResidentEvents = 0;
+};
+
+typedef TSharedPtr<const FCompiledPurposeTree, ESPMode::ThreadSafe> FCompiledPurposeTreePtr;
+
+#pragma endregion
+
 USTRUCT(BlueprintType)
 struct FSubjectMap
 {
@@ -241,13 +430,59 @@ public:
 	UPROPERTY(VisibleAnywhere)
 	///Link an enum representing a subject with a corresponding object which holds DataChunks
 	TMap<ESubject, TScriptInterface<IDataMapInterface>> subjects;
+
+	/// The handle of each subject within the world state blackboard
+	/// Resolved on the game thread when queuing, so that background threads only need the handle to read a subject's data
+	TMap<ESubject, FBlackboardHandle> blackboardIndices;
+
+	/// Game thread only, as the blackboard's registry is only ever modified on the game thread
+	void ResolveBlackboardIndices(const FPurposeBlackboard& blackboard)
+	{
+		blackboardIndices.Reset();
+		for (const TPair<ESubject, TScriptInterface<IDataMapInterface>>& subject : subjects)
+		{
+			const FBlackboardHandle handle = blackboard.EntityHandleOf(subject.Value.GetObject());
+			if (handle.IsSet())
+			{
+				blackboardIndices.Add(subject.Key, handle);
+			}
+		}
+	}
+
+	/// Combine another subject map with this one, the other's subjects take precedence just as TMap::Append would
+	void Append(const FSubjectMap& other)
+	{
+		subjects.Append(other.subjects);
+		for (const TPair<ESubject, TScriptInterface<IDataMapInterface>>& subject : other.subjects)
+		{
+			blackboardIndices.Remove(subject.Key);
+		}
+		blackboardIndices.Append(other.blackboardIndices);
+	}
 	
-	TMap<ESubject, TArray<FDataMapEntry>> GetSubjectsAsDataMaps() const
+	/// @param snapshot: When provided, subjects registered with the blackboard are read from the snapshot rather than their live data map
+	TMap<ESubject, TArray<FDataMapEntry>> GetSubjectsAsDataMaps(const FPurposeBlackboardSnapshot* snapshot = nullptr) const
 	{
 		TMap<ESubject, TArray<FDataMapEntry>> SubjectDataMap;
 
 		for (TPair<ESubject, TScriptInterface<IDataMapInterface>> subject : subjects)
 		{
+			if (snapshot)
+			{
+				const FBlackboardHandle* handle = blackboardIndices.Find(subject.Key);
+				if (const TArray<FDataMapEntry>* publishedDataMap = handle ? snapshot->DataMapFor(*handle) : nullptr)
+				{
+					SubjectDataMap.Add(subject.Key, *publishedDataMap);
+					continue;
+				}
+
+				if (handle && !snapshot->IsCurrent(*handle))
+				{
+					Global::Log(DATADEBUG, PURPOSE, "FSubjectMap", "GetSubjectsAsDataMaps", TEXT("Subject %s unregistered since it was queued, treating it as missing."), *Global::EnumValueOnly<ESubject>(subject.Key));
+					continue;/// Its index now belongs to another entity, and the subject itself may be gone
+				}
+			}
+
 			if (!IsValid(subject.Value.GetObject()))
 			{
 				Global::LogError(PURPOSE, "FContextData", "GetSubjectAsDataMaps", TEXT("Subject %s value is invalid!."), *Global::EnumValueOnly<ESubject>(subject.Key));
@@ -263,6 +498,169 @@ public:
 
 class IPurposeManagementInterface;
 
+/// <summary>
+/// Hands out the unique ID of every context tree, from any thread
+/// Each thread claims a block of IDs at a time, so the shared counter is only touched once per block
+/// IDs are never reused for the lifetime of the process, and 0 is never handed out
+/// </summary>
+struct FContextIDAllocator
+{
+	static constexpr int64 BlockSize = 1024;
+
+	static int64 Allocate()
+	{
+		if (nextInBlock == endOfBlock)
+		{
+			nextInBlock = nextBlock.fetch_add(BlockSize, std::memory_order_relaxed);
+			endOfBlock = nextInBlock + BlockSize;
+		}
+		return nextInBlock++;
+	}
+
+private:
+
+	/// Defined alongside the purpose threads
+	static std::atomic<int64> nextBlock;
+	static thread_local int64 nextInBlock;
+	static thread_local int64 endOfBlock;
+};
+
+/// <summary>
+/// The status and participants of each sub purpose of a context, indexed by the sub purpose's index within its parent
+/// Only sub purposes which have been selected are tracked, every tracked sub purpose still Ongoing is counted as incomplete
+/// So whether a context's sub purposes are complete is a single counter, which evaluation workers may read without locking
+/// Written on the game thread only
+/// </summary>
+struct FSubPurposeTracker
+{
+public:
+
+	FSubPurposeTracker() {}
+
+	/// @param numSubPurposes: Sized up front so that the slots never move while a worker may be reading them
+	explicit FSubPurposeTracker(const int32 numSubPurposes)
+	{
+		slots.SetNum(numSubPurposes);
+	}
+
+	FSubPurposeTracker(const FSubPurposeTracker& other)
+	{
+		*this = other;
+	}
+
+	FSubPurposeTracker& operator=(const FSubPurposeTracker& other)
+	{
+		slots = other.slots;
+		numTracked.store(other.numTracked.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		numIncomplete.store(other.numIncomplete.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		return *this;
+	}
+
+	/// Begins tracking the sub purpose as Ongoing, if it is not already tracked
+	void Track(const int32 slot)
+	{
+		if (slot < 0)
+		{
+			return;
+		}
+		if (slot >= slots.Num())
+		{
+			slots.SetNum(slot + 1);/// Only for contexts whose purpose did not come from the purpose tree
+		}
+		if (slots[slot].status.load(std::memory_order_relaxed) == (uint8)EPurposeState::None)
+		{
+			slots[slot].status.store((uint8)EPurposeState::Ongoing, std::memory_order_relaxed);
+			numTracked.fetch_add(1, std::memory_order_relaxed);
+			numIncomplete.fetch_add(1, std::memory_order_release);
+		}
+	}
+
+	bool IsTracked(const int32 slot) const
+	{
+		return slots.IsValidIndex(slot) && slots[slot].status.load(std::memory_order_relaxed) != (uint8)EPurposeState::None;
+	}
+
+	EPurposeState Status(const int32 slot) const
+	{
+		return slots.IsValidIndex(slot) ? StaticCast<EPurposeState>(slots[slot].status.load(std::memory_order_acquire)) : EPurposeState::None;
+	}
+
+	/// @return bool: False if the sub purpose is not tracked
+	bool SetStatus(const int32 slot, const EPurposeState status)
+	{
+		if (!IsTracked(slot) || status == EPurposeState::None)
+		{
+			return false;
+		}
+
+		const bool bWasOngoing = slots[slot].status.exchange((uint8)status, std::memory_order_acq_rel) == (uint8)EPurposeState::Ongoing;
+		const bool bIsOngoing = status == EPurposeState::Ongoing;
+		if (bWasOngoing != bIsOngoing)
+		{
+			numIncomplete.fetch_add(bIsOngoing ? 1 : -1, std::memory_order_release);
+		}
+		return true;
+	}
+
+	/// @return int32: The participants after the change, INDEX_NONE if the sub purpose is not tracked
+	int32 AddParticipant(const int32 slot)
+	{
+		return IsTracked(slot) ? slots[slot].participants.fetch_add(1, std::memory_order_relaxed) + 1 : INDEX_NONE;
+	}
+
+	int32 RemoveParticipant(const int32 slot)
+	{
+		if (!IsTracked(slot))
+		{
+			return INDEX_NONE;
+		}
+
+		int32 participants = slots[slot].participants.load(std::memory_order_relaxed);
+		while (participants > 0 && !slots[slot].participants.compare_exchange_weak(participants, participants - 1, std::memory_order_relaxed))
+		{
+		}
+		return FMath::Max(participants - 1, 0);
+	}
+
+	int32 Participants(const int32 slot) const
+	{
+		return slots.IsValidIndex(slot) ? slots[slot].participants.load(std::memory_order_relaxed) : 0;
+	}
+
+	int32 NumTracked() const { return numTracked.load(std::memory_order_relaxed); }
+
+	int32 NumIncomplete() const { return numIncomplete.load(std::memory_order_acquire); }
+
+	/// @return bool: True once at least one sub purpose is tracked and none remain Ongoing
+	bool AllComplete() const { return NumTracked() > 0 && NumIncomplete() == 0; }
+
+private:
+
+	struct FSlot
+	{
+		FSlot() {}
+		FSlot(const FSlot& other)
+			: status(other.status.load(std::memory_order_relaxed))
+			, participants(other.participants.load(std::memory_order_relaxed))
+		{}
+		FSlot& operator=(const FSlot& other)
+		{
+			status.store(other.status.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			participants.store(other.participants.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			return *this;
+		}
+
+		/// EPurposeState, None while untracked
+		std::atomic<uint8> status{ (uint8)EPurposeState::None };
+		std::atomic<int32> participants{ 0 };
+	};
+
+	TArray<FSlot> slots;
+
+	std::atomic<int32> numTracked{ 0 };
+	std::atomic<int32> numIncomplete{ 0 };
+};
+
 USTRUCT(BlueprintType)
 struct FContextData
 {
@@ -273,28 +671,48 @@ public:
 
 	FContextData() {}
 
-	FContextData(FPurpose inPurpose, FSubjectMap inSubjectMap, TArray<FDataMapEntry> inContextData, TScriptInterface<IPurposeManagementInterface> inPurposeOwner, FPurposeAddress inAddressForPurpose, FString descriptionOfParent = "", int32 parentID = 0)
-		: purpose(inPurpose)
-		, subjectMap(inSubjectMap)
+	/// Copies the purpose, for contexts whose purpose does not come from the compiled purpose tree
+	FContextData(FPurpose inPurpose, FSubjectMap inSubjectMap, TArray<FDataMapEntry> inContextData, TScriptInterface<IPurposeManagementInterface> inPurposeOwner, FPurposeAddress inAddressForPurpose, int64 parentID = 0)
+		: subjectMap(inSubjectMap)
 		, contextData(inContextData)
+		, addressOfPurpose(inAddressForPurpose)
 		, purposeOwner(inPurposeOwner)
+		, ownedPurpose(MakeShared<const FPurpose, ESPMode::ThreadSafe>(MoveTemp(inPurpose)))
+	{
+		purpose = ownedPurpose.Get();
+		InitializeID(parentID);
+	}
+
+	/// References the purpose within inPurposeTree rather than copying it, the context keeps the tree alive for as long as it exists
+	FContextData(const FPurpose* inPurpose, FCompiledPurposeTreePtr inPurposeTree, FSubjectMap inSubjectMap, TArray<FDataMapEntry> inContextData, TScriptInterface<IPurposeManagementInterface> inPurposeOwner, FPurposeAddress inAddressForPurpose, int64 parentID = 0)
+		: subjectMap(inSubjectMap)
+		, contextData(inContextData)
 		, addressOfPurpose(inAddressForPurpose)
+		, purposeOwner(inPurposeOwner)
+		, purpose(inPurpose)
+		, purposeTree(inPurposeTree)
 	{
-		contextDataPurposeName = purpose.descriptionOfPurpose + "(" + (purposeOwner.GetObject() ? purposeOwner.GetObject()->GetName() : "Invalid") + ")";
-		chainedPurposeName += descriptionOfParent.Len() > 0 ? "::" + descriptionOfParent : "";
-		
-		if (parentID == 0) /// If an existing ID is not provided, then we need to generate the initial unique ID for this context and all sub contexts
+		if (const FPurposeTreeNode* node = purposeTree.IsValid() ? purposeTree->FindNode(addressOfPurpose) : nullptr)
 		{
-			/// As the address of events are relevant to a single cache, each is different and thus when added to GetTicks, even if on the same Tick, will provide a different ID
-			uniqueIdentifier = addressOfPurpose.GetAddressOfThisPurpose() + FDateTime::UtcNow().GetTicks();
+			subPurposes = FSubPurposeTracker(node->numChildren);
 		}
+		InitializeID(parentID);
 	}
 
-	FPurpose purpose;
+	/// @return const FPurpose&: The purpose of this context, empty if there is none
+	const FPurpose& Purpose() const
+	{
+		static const FPurpose noPurpose;
+		return purpose ? *purpose : noPurpose;
+	}
 
 	/// We store the score of the purpose at the time of it's selection so that we may easily compare purposes against each other outside of purpose selection for an individual
 	float cachedScoreOfPurpose = 0;
 
+	/// Selected by FPurposeEvaluationThread::SelectJointPurposesIfPossible, which has already given this purpose the owner's place
+	/// The owner must take it regardless of cachedScoreOfPurpose, or the capacity of the sub purposes would no longer hold
+	bool bAssignedJointly = false;
+
 	/// Essentially this is the context
 	/// Every context will store relevant ESubjects with their data maps to be evaluated against Conditions
 	FSubjectMap subjectMap;
@@ -303,6 +721,9 @@ public:
 	/// We can store data specific to the context and not a subject here, such as a last known position, a type of sound heard, etc.
 	TArray<FDataMapEntry> contextData;
 
+	/// Context data which is a simple number or class, such as the action of an occurrence, stored inline rather than as a UDataChunk
+	FInlineDataMap contextValues;
+
 	/// Whenever a layer of purpose is added, the address adds a layer of address
 	/// So layer 1 will have a single address entry. But layer 2 will have the main address and a sub address, and so on so forth
 	FPurposeAddress addressOfPurpose;
@@ -312,20 +733,19 @@ public:
 	inline bool ContextIsValid() const { return addressOfPurpose.IsValid(); }
 
 	//inline bool HasPurpose() { return purpose.SubPurposes.Num() > 0 || purpose.BehaviorAbility; }
-	inline bool HasPurpose() const { return purpose.conditions.Num() > 0; }
+	inline bool HasPurpose() const { return Purpose().conditions.Num() > 0; }
 
-	///@return FString: If a purpose has been found for this contextData, returns the name of the purpose itself
-	FORCEINLINE FString GetName() const
+	/// Names are formatted from the purpose, owner and address each time they are asked for, never as the context is created or copied
+	///@return FString: If a purpose has been found for this contextData, returns the name of the purpose itself in the format of "Purpose(Owner)"
+	FString GetName() const
 	{
-		return contextDataPurposeName;
+		return Purpose().descriptionOfPurpose + "(" + OwnerName() + ")";
 	}
 
-	///Construct a loop of parentContext->contextDataPurposeName until a parentContext is no longer valid
-	///Returns a name in the format of "parentContext->contextDataPurposeName::contextDataPurposeName"
-	///@return the names of all purposes up to top of chain
-	FORCEINLINE FString GetPurposeChainName() const
+	///@return FString: The names of all purposes up to top of chain, in the format of "Event::Goal::Objective(Owner)"
+	FString GetPurposeChainName() const
 	{
-		return chainedPurposeName;
+		return purposeTree.IsValid() && purposeTree->FindNode(addressOfPurpose) ? purposeTree->DescribeChain(addressOfPurpose) + "(" + OwnerName() + ")" : GetName();
 	}
 
 	FString Description() const
@@ -425,69 +845,59 @@ public:
 		return *name;
 	}
 
-	///The name adjusted to represent the selected purpose
-	FString contextDataPurposeName = "contextData";
-	///The name utilized to represent a chain of ParentContext->ChildContext
-	FString chainedPurposeName = "contextData";
-
 	const int64 GetContextID() const { return uniqueIdentifier; }
 
-	UPROPERTY()
-		/// This map links the Purpose.SubPurposes() to a "static" purpose state
-		/// It allows us to reference the completion status of a sub purpose
-		/// Which can in turn be used to determine completion status of this purpose
-		/// FTrackedPurposeEntry is the address of each individual sub purpose linked to the unique context ID for tree of purposes
-		TMap<FPurposeAddress, EPurposeState> subPurposeStatus;
+	/// Links each sub purpose, by its index within this purpose, to its state and participants
+	/// Which can in turn be used to determine completion status of this purpose
+	FSubPurposeTracker subPurposes;
 
-	UPROPERTY()
-		/// This map represents how many participants there are for sub purposes
-		/// FTrackedPurposeEntry is the address of each individual sub purpose linked to the unique context ID for tree of purposes
-		TMap<FPurposeAddress, int> subPurposeParticipants;
+	/// Sub purposes only need to be tracked once, as they are already stored within a context
+	void TrackSubPurpose(const FPurposeAddress& subPurpose)
+	{
+		subPurposes.Track(subPurpose.GetAddressOfThisPurpose());
+	}
 
 	bool UpdateSubPurposeStatus(const FPurposeAddress& subPurpose, EPurposeState status)
 	{
-		if (subPurposeStatus.Find(subPurpose))/// If the objective class matches update the status
+		if (subPurposes.SetStatus(subPurpose.GetAddressOfThisPurpose(), status))
 		{
-			Global::Log(DATATRIVIAL, PURPOSE, GetName(), "UpdateSubPurposeStatus", TEXT("SubPurpose %s status is now."), *subPurpose.GetAddressAsString(), *Global::EnumValueOnly<EPurposeState>(status));
-			subPurposeStatus[subPurpose] = status;
+			Global::Log(DATATRIVIAL, PURPOSE, GetName(), "UpdateSubPurposeStatus", TEXT("SubPurpose %s status is now %s."), *subPurpose.GetAddressAsString(), *Global::EnumValueOnly<EPurposeState>(status));
 			return true;
 		}
-		else
-		{
-			Global::LogError(PURPOSE, GetName(), "UpdateSubPurposeStatus", TEXT("SubPurpose %s was not found in subPurposeStatus."), *subPurpose.GetAddressAsString());
-		}
 
+		Global::LogError(PURPOSE, GetName(), "UpdateSubPurposeStatus", TEXT("SubPurpose %s was not found in subPurposes."), *subPurpose.GetAddressAsString());
 		return false;
 	}
 
 	bool IncreaseSubPurposeParticipants(const FPurposeAddress& subPurpose)
 	{
-		if (subPurposeParticipants.Find(subPurpose))/// If the objective class matches update the status
+		const int32 participants = subPurposes.AddParticipant(subPurpose.GetAddressOfThisPurpose());
+		if (participants != INDEX_NONE)
 		{
-			subPurposeParticipants[subPurpose]++;
-			Global::Log(DATATRIVIAL, PURPOSE, GetName(), "IncreaseSubPurposeParticipants", TEXT("SubPurpose %s participants now %d."), *subPurpose.GetAddressAsString(), subPurposeParticipants[subPurpose]);
+			Global::Log(DATATRIVIAL, PURPOSE, GetName(), "IncreaseSubPurposeParticipants", TEXT("SubPurpose %s participants now %d."), *subPurpose.GetAddressAsString(), participants);
 			return true;
 		}
-		else
-		{
-			Global::LogError(PURPOSE, GetName(), "IncreaseSubPurposeParticipants", TEXT("SubPurpose %s was not found in ObjectiveParticipants."), *subPurpose.GetAddressAsString());
-		}
 
+		Global::LogError(PURPOSE, GetName(), "IncreaseSubPurposeParticipants", TEXT("SubPurpose %s was not found in subPurposes."), *subPurpose.GetAddressAsString());
 		return false;
 	}
 
+	/// @return int32: The participants of the sub purpose, 0 if it is not tracked
+	int32 SubPurposeParticipants(const FPurposeAddress& subPurpose) const
+	{
+		return subPurposes.Participants(subPurpose.GetAddressOfThisPurpose());
+	}
+
 	bool DecreaseSubPurposeParticipants(const FPurposeAddress& subPurpose)
 	{
-		if (subPurposeParticipants.Find(subPurpose))/// If the objective class matches update the status
+		const int32 participants = subPurposes.RemoveParticipant(subPurpose.GetAddressOfThisPurpose());
+		if (participants != INDEX_NONE)
 		{
-			subPurposeParticipants[subPurpose]++;
-			Global::Log(DATATRIVIAL, PURPOSE, GetName(), "DecreaseSubPurposeParticipants", TEXT("SubPurpose %s participants now %d."), *subPurpose.GetAddressAsString(), subPurposeParticipants[subPurpose]);
+			Global::Log(DATATRIVIAL, PURPOSE, GetName(), "DecreaseSubPurposeParticipants", TEXT("SubPurpose %s participants now %d."), *subPurpose.GetAddressAsString(), participants);
 			return true;
 		}
-		else
-		{
-			Global::LogError(PURPOSE, GetName(), "DecreaseSubPurposeParticipants", TEXT("SubPurpose %s was not found in ObjectiveParticipants."), *subPurpose.GetAddressAsString());
-		}
+
+		Global::LogError(PURPOSE, GetName(), "DecreaseSubPurposeParticipants", TEXT("SubPurpose %s was not found in subPurposes."), *subPurpose.GetAddressAsString());
 		return false;
 	}
 
@@ -497,6 +907,26 @@ private:
 	/// This is a means of identifying tracked purposes based on the address and this ID
 	/// We can not use address alone as a purpose may be reused multiple times for different contexts
 	int64 uniqueIdentifier = 0;
+
+	/// Points into purposeTree, or into ownedPurpose when the purpose did not come from a tree
+	const FPurpose* purpose = nullptr;
+
+	/// Held so the purpose remains valid after the director compiles a new tree
+	FCompiledPurposeTreePtr purposeTree;
+
+	TSharedPtr<const FPurpose, ESPMode::ThreadSafe> ownedPurpose;
+
+	FString OwnerName() const
+	{
+		return purposeOwner.GetObject() ? purposeOwner.GetObject()->GetName() : TEXT("Invalid");
+	}
+
+	void InitializeID(const int64 parentID)
+	{
+		/// If an existing ID is not provided, then we need to generate the initial unique ID for this context and all sub contexts
+		/// Otherwise this context joins the context tree of its parent
+		uniqueIdentifier = parentID != 0 ? parentID : FContextIDAllocator::Allocate();
+	}
 #pragma endregion
 
 #pragma region Subjects
@@ -631,11 +1061,12 @@ public:
 				{
 					Global::Log(DATATRIVIAL, PURPOSE, GetPurposeChainName(), "AdjustData", TEXT("Adjusting %s by %d."), *adjustmentChunk->GetClass()->GetName(), (int)adjustmentChunk->DataModifier());
 					DataMapInterfaceForSubject(target)->DataChunk(adjustmentChunk->GetClass())->AdjustData(adjustmentChunk->DataModifier());/// Adjust the data by the specified modifier
+					IncrementDataMapVersionOfSubject(target);/// The chunk was modified in place, so the data map itself never saw the change
 				}
 				else/// Otherwise create the data chunk
 				{
 					Global::Log(DATATRIVIAL, PURPOSE, GetPurposeChainName(), "AdjustData", TEXT("Creating DataChunk %s with modification %d."), *adjustmentChunk->GetClass()->GetName(), (int)adjustmentChunk->DataModifier());
-					DataMapInterfaceForSubject(target)->AddData(NewObject<UDataChunk>(Subject(target), adjustmentChunk->GetClass())->AdjustData(adjustmentChunk->DataModifier()));/// And still apply the modification requested
+					DataMapInterfaceForSubject(target)->AddData(AcquireDataChunk(adjustmentChunk->GetClass(), Subject(target))->AdjustData(adjustmentChunk->DataModifier()));/// And still apply the modification requested
 				}
 				return true;
 			}
@@ -663,6 +1094,15 @@ public:
 		return false;
 	}
 
+	/// Chunks are taken from the data chunk pool of the recipient when possible, as adjustments can create them in bulk
+	/// @param recipient: The subject the chunk is created for
+	/// @return UDataChunk*: Never nullptr so long as chunkClass is valid
+	UDataChunk* AcquireDataChunk(TSubclassOf<UDataChunk> chunkClass, UObject* recipient) const;
+
+	/// Ensures the subject's data map version reflects a chunk being adjusted in place
+	/// Defined in the .cpp as IPurposeManagementInterface is not yet complete here
+	void IncrementDataMapVersionOfSubject(ESubject inSubject) const;
+
 	/// Will perform Purpose's DataAdjustements as appropriate
 	/// @param inEventTypeToAdjust: Determines what data can be adjusted based on selection made in Asset
 	/// @param inLogCat: Allows us to clarify where adjustment is coming from in fail case
@@ -698,9 +1138,10 @@ public:
 		return addressOfPurpose == other.addressOfPurpose && uniqueIdentifier == other.uniqueIdentifier;
 	}
 };
+/// Consistent with operator==, so only the ID and address are hashed, never the subjects or data of the context
 FORCEINLINE uint32 GetTypeHash(const FContextData& b)
 {
-	return FCrc::MemCrc32(&b, sizeof(FContextData));
+	return HashCombine(GetTypeHash(b.GetContextID()), GetTypeHash(b.addressOfPurpose));
 }
 
 USTRUCT(BlueprintType)
@@ -711,9 +1152,11 @@ public:
 
 	FPotentialPurposeEntry() {}
 
-	FPotentialPurposeEntry(FPurpose inPurpose, FPurposeAddress inAddress, TArray<FSubjectMap> inUniqueSubjectMap)
-		: purposeToBeEvaluated(inPurpose)
-		, addressOfPurpose(inAddress)
+	FPotentialPurposeEntry(const FPurposeTreeNode& inNode, TArray<FSubjectMap> inUniqueSubjectMap)
+		: addressOfPurpose(inNode.address)
+		, purposeToBeEvaluated(inNode.purpose)
+		, potentialScore(inNode.potentialScore)
+		, totalWeight(inNode.totalWeight)
 		, mapOfUniqueSubjectEntriesForPurpose(inUniqueSubjectMap)
 	{
 	}
@@ -722,7 +1165,12 @@ public:
 	FPurposeAddress addressOfPurpose;
 
 	/// This is the actual purpose that will be evaluated against the subject map established specifically for this purpose, + the static subject map from the context
-	FPurpose purposeToBeEvaluated;
+	/// Points into FPotentialPurposes::purposeTree, which keeps it alive until evaluation is done
+	const FPurpose* purposeToBeEvaluated = nullptr;
+
+	/// Compiled with the purpose tree, see FPurpose::Potential
+	float potentialScore = 0.0f;
+	float totalWeight = 0.0f;
 
 	/// The PotentialSubjectMaps are a combination of 1 UniqueSubject and any other entries desired
 	/// The StaticSubjectMap will be appended to the PotentialSubjectMap at evaluation, the highest scoring pair becomes the new StaticSubjectMap
@@ -730,6 +1178,30 @@ public:
 
 };
 
+/// <summary>
+/// The subjects and data of a parent context, shared by every FPotentialPurposes queued for its candidates
+/// Created once per fan-out and immutable once shared, so the background threads may read it without copying it per candidate
+/// </summary>
+struct FPotentialPurposesParent
+{
+	FPotentialPurposesParent() {}
+	FPotentialPurposesParent(const FSubjectMap& inSubjectMap, const TArray<FDataMapEntry>& inContextData, const FInlineDataMap& inContextValues)
+		: staticSubjectMap(inSubjectMap)
+		, contextData(inContextData)
+		, contextValues(inContextValues)
+	{}
+
+	/// Subject map for the potential purposes to evaluate against
+	FSubjectMap staticSubjectMap;
+
+	/// Context data for the potential purposes to evaluate against
+	TArray<FDataMapEntry> contextData;
+
+	/// The inline counterpart of contextData
+	FInlineDataMap contextValues;
+};
+typedef TSharedPtr<const FPotentialPurposesParent, ESPMode::ThreadSafe> FPotentialPurposesParentPtr;
+
 USTRUCT(BlueprintType)
 struct FPotentialPurposes
 {
@@ -744,37 +1216,91 @@ public:
 	/// A combination of a potential purpose and the UniqueSubject entries for that specific purpose
 	TArray<FPotentialPurposeEntry> potentialPurposes;
 
+	/// The tree every potential purpose was taken from, held so they remain valid on the background thread
+	FCompiledPurposeTreePtr purposeTree;
+
 	int AddressLayer = -1;
 
 	/// We store the parent address here so that, when selected, the selected sub purpose may create their full address
 	const FPurposeAddress addressOfParentPurpose;
 
-	/// Subject map for the potential purposes to evaluate against
-	FSubjectMap staticSubjectMapForPotentialPurposes;
-
 	/// This is the 1 UniqueSubject for which this FPotentialPurpose exists
 	TScriptInterface<IPurposeManagementInterface> purposeOwner = nullptr;
 
-	/// Context data for the potential purposes to evaluate against
-	TArray<FDataMapEntry> ContextDataForPotentialPurposes;
+	/// Shared by every candidate of the parent context, see CreateParent
+	FPotentialPurposesParentPtr parent;
 
-	FString DescriptionOfParentPurpose = "";
+	const FSubjectMap& StaticSubjectMap() const { return parent.IsValid() ? parent->staticSubjectMap : EmptyParent().staticSubjectMap; }
+	const TArray<FDataMapEntry>& ContextData() const { return parent.IsValid() ? parent->contextData : EmptyParent().contextData; }
+	const FInlineDataMap& ContextValues() const { return parent.IsValid() ? parent->contextValues : EmptyParent().contextValues; }
+
+	/// Must be called on the game thread, the blackboard indices of the subject map are resolved before it is shared
+	static FPotentialPurposesParentPtr CreateParent(const FSubjectMap& subjectMap, const TArray<FDataMapEntry>& contextData, const FInlineDataMap& contextValues, const FPurposeBlackboard* blackboard)
+	{
+		TSharedPtr<FPotentialPurposesParent, ESPMode::ThreadSafe> newParent = MakeShared<FPotentialPurposesParent, ESPMode::ThreadSafe>(subjectMap, contextData, contextValues);
+		if (blackboard)
+		{
+			newParent->staticSubjectMap.ResolveBlackboardIndices(*blackboard);
+		}
+		return newParent;
+	}
 
 	/// This unique id is meant to provide every context data witthin a single event a unifying id
 	/// This is a means of identifying tracked purposes based on the address and this ID
 	/// We can not use address alone as a purpose may be reused multiple times for different contexts
 	const int64 uniqueIdentifierOfParent;
 
-	void SetDescriptionOfParentPurpose(TScriptInterface<IPurposeManagementInterface > parentOwner, FString parentDescription)
+	/// Only for logging, formatted from addressOfParentPurpose each time it is asked for
+	/// @return FString: The chain of purposes leading to the parent, in the format of "Event::Goal", empty for Events
+	FString DescriptionOfParentPurpose() const
+	{
+		return purposeTree.IsValid() ? purposeTree->DescribeChain(addressOfParentPurpose) : FString();
+	}
+
+	/// Must be called on the game thread once the subject maps are final, just prior to queuing
+	/// The parent's subject map is resolved by CreateParent
+	void ResolveBlackboardIndices(const FPurposeBlackboard* blackboard)
 	{
-		DescriptionOfParentPurpose = FString::Printf(TEXT("%s::%s"), *parentDescription, IsValid(parentOwner.GetObject()) ? *parentOwner.GetObject()->GetName() : TEXT("Invalid"));
+		if (!blackboard)
+		{
+			return;
+		}
+
+		for (FPotentialPurposeEntry& entry : potentialPurposes)
+		{
+			for (FSubjectMap& uniqueSubjects : entry.mapOfUniqueSubjectEntriesForPurpose)
+			{
+				uniqueSubjects.ResolveBlackboardIndices(*blackboard);
+			}
+		}
 	}
 
-	void SetDescriptionOfParentPurpose(const FContextData& parentContext)
+private:
+
+	static const FPotentialPurposesParent& EmptyParent()
 	{
-		DescriptionOfParentPurpose = parentContext.GetName();
+		static const FPotentialPurposesParent empty;
+		return empty;
 	}
+};
 
+/// <summary>
+/// The FPotentialPurposes of every candidate of a parent context, evaluated together so sub purposes are shared out between the candidates rather than each taking its own best
+/// See IPurposeManagementInterface::AssignSubPurposesJointly
+/// </summary>
+struct FJointPotentialPurposes
+{
+	/// Each shares the same parent payload, see FPotentialPurposesParent
+	TArray<FPotentialPurposes> candidates;
+
+	/// How many more candidates each sub purpose may take, by its index beneath the parent
+	/// Sub purposes without an entry take any number of candidates
+	TMap<int32, int32> capacityOfSubPurpose;
+
+	/// The index of the sub purpose each candidate already takes part in beneath the parent, by the candidate's purpose owner
+	/// Its place is only returned to capacityOfSubPurpose once the candidate is assigned elsewhere, as a candidate assigned nothing keeps it
+	/// Only ever compared against FPotentialPurposes::purposeOwner, never dereferenced off the game thread
+	TMap<const UObject*, int32> heldSubPurposeOfCandidate;
 };
 
 ///Umbrella type for multiple queues of UContextData_Deprecated
@@ -782,6 +1308,25 @@ typedef TQueue<TObjectPtr<UContextData_Deprecated>> PurposeQueue;
 
 class FAsyncGraphTask_PurposeSelected;
 
+/// <summary>
+/// A request for a purpose thread to evaluate the completionCriteria of a context, such as an Objective once one of its abilities has finished
+/// Only the resulting EPurposeState is posted back, see IPurposeManagementInterface::CompletionEvaluated
+/// </summary>
+struct FCompletionCheck
+{
+	FCompletionCheck() {}
+	FCompletionCheck(const FContextData& inContext, TScriptInterface<class IPurposeManagementInterface> inRequester)
+		: context(inContext)
+		, requester(inRequester)
+	{}
+
+	/// A copy, holding the purpose tree alive so the criteria remain valid until evaluated
+	FContextData context;
+
+	/// Who the result is posted back to
+	TScriptInterface<class IPurposeManagementInterface> requester = nullptr;
+};
+
 /// <summary>
 ///The purpose evaluation thread is the foundation of all gameplay logic
 ///Receiving a context data, the thread will compare that context data to a relevant layer of purpose
@@ -802,6 +1347,10 @@ public:
 	///Essentially the speed that the background thread will call Run(); thanks to FPlatformMisc::Sleep()
 	float tickTimer = 0.05f;
 
+	/// Owned by the head of purpose management, which outlives the thread
+	/// When set, subject data is read from the blackboard's front buffer rather than from the subjects themselves
+	const FPurposeBlackboard* blackboard = nullptr;
+
 	/// Design: BackgroundThread Purpose; to implement a pause using FRunnable::Suspend
 		/// halt any evaluation regardless of status
 		/// Throw context data into a tgraphtask to re-add to it's queue
@@ -841,12 +1390,90 @@ public:
 	///@return bool: 
 	bool SelectPurposeIfPossible(FPotentialPurposes& purposeToEvaluate);
 
+	/// Scores every combination of every candidate, then hands each candidate the best purpose which still has capacity, highest scores first
+	///@return bool: True if any candidate was handed a purpose
+	bool SelectJointPurposesIfPossible(FJointPotentialPurposes& jointPurposes);
+
+	/// Taken by whichever thread evaluates the layer of the candidates' purposes
+	/// @param jointPurposesToQueue: Moved from only when queued, so it may be offered to the next thread otherwise
+	///@return bool: True when the joint purposes were stored to be evaluated
+	bool QueueJointPurposes(FJointPotentialPurposes& jointPurposesToQueue)
+	{
+		if (jointPurposesToQueue.candidates.Num() > 0 && potentialPurposeQueues.Contains((uint8)jointPurposesToQueue.candidates[0].AddressLayer))
+		{
+			jointPurposeQueue.Enqueue(MoveTemp(jointPurposesToQueue));
+			return true;
+		}
+		return false;
+	}
+
+	///@return bool: False only when there were no joint purposes to evaluate
+	bool EvaluateNextJointPurposes();
+
+	/// Completion checks are taken by whichever thread evaluates Objectives
+	///@return bool: True when the check was stored to be evaluated
+	bool QueueCompletionCheck(FCompletionCheck checkToQueue)
+	{
+		if (potentialPurposeQueues.Contains((uint8)EPurposeLayer::Objective))
+		{
+			completionChecks.Enqueue(MoveTemp(checkToQueue));
+			return true;
+		}
+		return false;
+	}
+
+	/// Evaluates the completionCriteria of the next queued check, then posts the resulting state back to the game thread
+	/// Called ahead of purpose selection, as a candidate waits on the result before it may continue
+	///@return bool: False only when there was no check to evaluate
+	bool EvaluateNextCompletionCheck();
+
+	/// Conditions are handed the context as data chunks, which can not include the inline values of the context
+	/// While conditions are evaluated, on a purpose thread or by UPurposeAbilityComponent::EvaluateObjectiveStatus, this provides them those values without altering UCondition::EvaluateCondition
+	/// @return const FInlineDataMap*: nullptr when called outside of condition evaluation
+	static const FInlineDataMap* ContextValuesUnderEvaluation() { return contextValuesUnderEvaluation; }
+
+	/// The value conditions read in place of a chunk of the context, such as the UActorAction of an occurrence, which is only ever stored inline
+	/// @return const FDataValue*: nullptr when the context under evaluation holds no value for key, or outside of condition evaluation
+	static const FDataValue* ContextValue(const UClass* key) { return contextValuesUnderEvaluation ? contextValuesUnderEvaluation->Find(key) : nullptr; }
+
+	/// Provides values to ContextValue for as long as it is in scope, for conditions evaluated outside of a purpose thread
+	struct FScopedContextValues : private TGuardValue<const FInlineDataMap*>
+	{
+		explicit FScopedContextValues(const FInlineDataMap& values)
+			: TGuardValue<const FInlineDataMap*>(contextValuesUnderEvaluation, &values)
+		{}
+	};
+
 protected:
 
 	TMap<uint8, TQueue<FPotentialPurposes>> potentialPurposeQueues;
 
-	bool CreateAsyncTask_PurposeSelected(FContextData& context);
+	TQueue<FCompletionCheck> completionChecks;
+
+	TQueue<FJointPotentialPurposes> jointPurposeQueue;
+
+	/// A single combination of a candidate, a potential purpose and a set of subjects, as scored by SelectJointPurposesIfPossible
+	struct FJointScore
+	{
+		float score = 0.0f;
+		int32 candidateIndex = 0;
+		int32 entryIndex = 0;
+		int32 combinationIndex = 0;
+	};
+
+	/// @param minimumScore: Scoring stops early once the combination can no longer exceed this
+	/// @return float: The score of the combination, 0 if it fell short of minimumScore or a required condition
+	float ScoreSubjectCombination(const FPotentialPurposes& purposeToEvaluate, const FPotentialPurposeEntry& purpose, const FSubjectMap& subjectCombination, const FPurposeBlackboardSnapshot* worldState, const float minimumScore);
+
+	/// Posts the purpose back to its owner, or a re-occurrence should the owner already hold it
+	/// @param bAssignedJointly: See FContextData::bAssignedJointly
+	void PurposeFound(const FPotentialPurposes& purposeToEvaluate, const FPotentialPurposeEntry& purpose, const FSubjectMap& subjectCombination, const float score, const bool bAssignedJointly = false);
+
+	static thread_local const FInlineDataMap* contextValuesUnderEvaluation;
+
+	bool CreateAsyncTask_PurposeSelected(FContextData&& context);
 	bool FPurposeEvaluationThread::CreateAsyncTask_ReOccurrence(TScriptInterface<class IPurposeManagementInterface> owner, const FPurposeAddress addressOfPurpose, const int64 outUniqueIDofActivePurpose);
+	bool CreateAsyncTask_CompletionEvaluated(TScriptInterface<class IPurposeManagementInterface> requester, const int64 uniqueContextID, const FPurposeAddress addressOfPurpose, const EPurposeState status);
 
 };
 
@@ -873,6 +1500,41 @@ public:
 
 	virtual TArray<FPurposeEvaluationThread*> GetBackgroundPurposeThreads() = 0;
 
+	/// @return uint32: Raised whenever the implementer's data map may have changed, so copies of it can be reused until it does
+	virtual uint32 DataMapVersion() const = 0;
+
+	/// Must be called whenever a chunk of the implementer's data map is modified in place, such as by UDataChunk::AdjustData
+	/// AddData, AppendData, RemoveData and replication raise the version themselves, DataMapInternal() does not as lookups also use it
+	virtual void IncrementDataMapVersion() = 0;
+
+	/// @return FPurposeBlackboard*: The world state blackboard owned by the head of purpose management, nullptr if there is none
+	virtual FPurposeBlackboard* GetWorldStateBlackboard() = 0;
+
+	/// @return FDataChunkPool*: The chunk pool of the implementer's own data map, nullptr if there is none
+	virtual FDataChunkPool* GetDataChunkPool() = 0;
+
+	/// Returns a chunk removed from, or replaced in, the implementer's data map to its data chunk pool, should the pool have handed it out
+	void ReleaseDataChunk(UDataChunk* chunk)
+	{
+		FDataChunkPool* pool = GetDataChunkPool();
+		if (chunk && pool)
+		{
+			pool->Release(chunk);
+		}
+	}
+
+	/// @return FPurposeContextStore*: The context store owned by the head of purpose management, nullptr if there is none
+	virtual struct FPurposeContextStore* GetContextStore() = 0;
+
+	/// @return FContextTreeRegistry*: The registry of active context trees owned by the head of purpose management, nullptr if there is none
+	virtual struct FContextTreeRegistry* GetContextTreeRegistry() = 0;
+
+	/// @return FPurposeSpatialGrid*: The spatial grid of purpose components owned by the head of purpose management, nullptr if there is none
+	virtual struct FPurposeSpatialGrid* GetSpatialGrid() = 0;
+
+	/// @return FPurposeComponentRegistry*: The registry resolving actors to their purpose component, owned by the head of purpose management, nullptr if there is none
+	virtual struct FPurposeComponentRegistry* GetPurposeComponentRegistry() = 0;
+
 	/// @return TArray<TScriptInterface<IDataMapInterface>>: Every candidate we wish to select a purpose for
 	virtual TArray<TScriptInterface<IDataMapInterface>> GetCandidatesForSubPurposeSelection(const int PurposeLayerForUniqueSubjects) = 0;
 
@@ -882,24 +1544,40 @@ public:
 	/// @return TArray<FSubjectMap>: Each entry is a combination of the candidate and whatever other subjects required for the subpurpose indicated by addressOfSubPurpose
 	virtual TArray<FSubjectMap> GetUniqueSubjectsRequiredForSubPurposeSelection(const int PurposeLayerForUniqueSubjects, const FContextData& parentContext, TScriptInterface<IDataMapInterface> candidate, FPurposeAddress addressOfSubPurpose) = 0;
 
+	/// Called once as the sub purposes of parentContext are queued, before GetUniqueSubjectsRequiredForSubPurposeSelection is called for any candidate
+	/// Allows subjects which are costly to find, such as targets found through EQS, to be gathered over several frames and shared between candidates
+	/// @return bool: True when gathering has begun, the implementer must then call PurposeSystem::QueueSubPurposesForCandidates with parentContext once it has finished
+	virtual bool GatherSubjectsForSubPurposeSelection(const int PurposeLayerForUniqueSubjects, const FContextData& parentContext, TArrayView<const FPurposeTreeNode> subPurposes) { return false; }
+
+	/// Allows the implementer to have the sub purposes of parentContext shared out between all of its candidates in a single evaluation, rather than each candidate selecting alone
+	/// @param outJointPurposes: Filled with how many more candidates each sub purpose may take, and which sub purpose each candidate already holds
+	/// @return bool: True to evaluate the candidates jointly
+	virtual bool AssignSubPurposesJointly(const int PurposeLayerForUniqueSubjects, const FContextData& parentContext, TArrayView<const FPurposeTreeNode> subPurposes, FJointPotentialPurposes& outJointPurposes) { return false; }
+
 	virtual bool ProvidePurposeToOwner(const FContextData& purposeToStore) = 0;
 
 	/// Events must be stored globally for the duration of a game so that they may have a consistent PurposeAddress
-	virtual TArray<FPurpose> GetEventAssets() = 0;
-
-	/// As FPurpose can not hold an variable or TArray<> of itself, we're forced to workaround simply accessing subpurposes
-	virtual TArray<FPurpose> GetSubPurposesFor(FPurposeAddress address) = 0;
+	/// As FPurpose can not hold an variable or TArray<> of itself, sub purposes are accessed through the compiled tree by address
+	/// @return FCompiledPurposeTreePtr: The current tree of the head of purpose management, invalid until Events have been loaded
+	virtual FCompiledPurposeTreePtr GetPurposeTree() = 0;
 
 	virtual const TArray<FContextData>& GetActivePurposes() = 0;
 
 	/// When a purpose is put up for selection, but it appears to be a duplicate of a current purpose, we want to let the purpose owner handle the reoccurrence
 	virtual void PurposeReOccurrence(const FPurposeAddress addressOfPurpose, const int64 uniqueIDofActivePurpose) = 0;
 
+	/// The result of a FCompletionCheck this requested, posted back to the game thread
+	virtual void CompletionEvaluated(const int64 uniqueContextID, const FPurposeAddress& addressOfPurpose, const EPurposeState status) = 0;
+
 	/// @param uniqueIdentifierOfContextTree: This ID unique to a series of context datas starting with Event allows separation of same purposes for different contexts
 	/// @param fullAddress: Tying the address to the unique ID is how we can search stored contexts for the relevant context we seek
 	/// @param layerToRetrieveFor: We may not necessarily wish to find the end address of the fullAddress, so we can indicate a layer to seek out
-	/// @return FContextData&: Need to check for validity as the context data may not have been found and an empty struct returned
-	virtual FContextData& GetStoredPurpose(const int64 uniqueIdentifierOfContextTree, const FPurposeAddress& fullAddress, const int layerToRetrieveFor) = 0;
+	/// @return FContextData*: The stored context itself, nullptr if it was not found
+	virtual FContextData* GetStoredPurpose(const int64 uniqueIdentifierOfContextTree, const FPurposeAddress& fullAddress, const int layerToRetrieveFor) = 0;
+
+	/// Must be called once a context returned by GetStoredPurpose has been changed in place, so that whichever owner stores it may update what it publishes of it
+	/// Forwarded up the management chain the same way as GetStoredPurpose
+	virtual void StoredPurposeChanged(const FContextData& storedContext) = 0;
 
 	/// @param parentAddress: An address which is either that of a purpose containing behaviors so that it may reference the parent, or the parent address itself
 	/// @param TArray<TObjectPtr<UGA_Behavior>>: All the behaviors contained by the parent indicated
@@ -910,7 +1588,7 @@ public:
 	virtual TObjectPtr<class UBehavior_AI> GetBehaviorAtAddress(const FPurposeAddress& inAddress) = 0;
 
 	///@return bool: Determined by the implementer
-	virtual bool DoesPurposeAlreadyExist(const FContextData& primary, const FSubjectMap& secondarySubjects, const TArray<FDataMapEntry>& secondaryContext, const FPurposeAddress optionalAddress = FPurposeAddress()) = 0;
+	virtual bool DoesPurposeAlreadyExist(const FContextData& primary, const FSubjectMap& secondarySubjects, const TArray<FDataMapEntry>& secondaryContext, const FInlineDataMap& secondaryValues, const FPurposeAddress optionalAddress = FPurposeAddress()) = 0;
 
 	virtual void SubPurposeCompleted(const int64& uniqueContextID, const FPurposeAddress& addressOfPurpose) = 0;
 
@@ -920,6 +1598,30 @@ public:
 namespace PurposeSystem
 {
 
+	/// Must be called on the game thread, so the subjects of the check may be read from the blackboard
+	///@return bool: False when no thread accepted the check, in which case the requester must evaluate it itself
+	static bool QueueCompletionCheck(FCompletionCheck check, TScriptInterface<IPurposeManagementInterface> requester)
+	{
+		if (!IsValid(requester.GetObject()))
+		{
+			return false;
+		}
+
+		if (FPurposeBlackboard* blackboard = requester->GetWorldStateBlackboard())
+		{
+			check.context.subjectMap.ResolveBlackboardIndices(*blackboard);
+		}
+
+		for (FPurposeEvaluationThread* thread : requester->GetBackgroundPurposeThreads())
+		{
+			if (thread && thread->QueueCompletionCheck(check))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
 	static bool QueuePurposeToBackgroundThread(FPotentialPurposes potentialPurposes, TArray<FPurposeEvaluationThread*> potentialThreadsToQueueOn)
 	{
 		/// Since we have a queue purpose on the background threads which queue based on a switch statement for the address level
@@ -938,7 +1640,21 @@ namespace PurposeSystem
 		return false;
 	}
 
-	static bool Occurrence(FSubjectMap subjectsOfContext, TArray<FDataMapEntry> context, TScriptInterface<IPurposeManagementInterface> purposeOwner)
+	static bool QueueJointPurposesToBackgroundThread(FJointPotentialPurposes jointPurposes, TArray<FPurposeEvaluationThread*> potentialThreadsToQueueOn)
+	{
+		for (FPurposeEvaluationThread* thread : potentialThreadsToQueueOn)
+		{
+			if (thread->QueueJointPurposes(jointPurposes))
+			{
+				return true;
+			}
+		}
+		Global::LogError(PURPOSE, "PurposeSystem", "QueueJointPurposesToBackgroundThread", TEXT("No thread evaluates layer %d!"), jointPurposes.candidates.Num() > 0 ? jointPurposes.candidates[0].AddressLayer : -1);
+		return false;
+	}
+
+	/// @param contextValues: Context which is a simple number or class, such as the action performed, is best provided here to avoid creating a UDataChunk per occurrence
+	static bool Occurrence(FSubjectMap subjectsOfContext, TArray<FDataMapEntry> context, TScriptInterface<IPurposeManagementInterface> purposeOwner, FInlineDataMap contextValues = FInlineDataMap())
 	{
 		if (!IsValid(purposeOwner.GetObject()) && IsValid(purposeOwner->GetHeadOfPurposeManagment().GetObject()))
 		{
@@ -952,7 +1668,7 @@ namespace PurposeSystem
 		/// Before we even bother with potential purposes for an occurrence, let's make sure it doesn't already exist
 		for (const FContextData& eventContext : headOfPurposeManagement->GetActivePurposes())
 		{
-			if (headOfPurposeManagement->DoesPurposeAlreadyExist(eventContext, subjectsOfContext, context))
+			if (headOfPurposeManagement->DoesPurposeAlreadyExist(eventContext, subjectsOfContext, context, contextValues))
 			{
 				Global::Log( DATATRIVIAL, EVENT, "PurposeSystem", "Occurrence", TEXT("Provided an invalid Occurrence already exists!"));
 				return false;
@@ -960,9 +1676,10 @@ namespace PurposeSystem
 			}
 		}
 
-		if (headOfPurposeManagement->GetEventAssets().Num() < 1)
+		FCompiledPurposeTreePtr purposeTree = headOfPurposeManagement->GetPurposeTree();
+		if (!purposeTree.IsValid() || purposeTree->NumResidentEvents() < 1)
 		{
-			Global::LogError(EVENT, "PurposeSystem", "Occurrence", TEXT("No Event Assets!"));
+			Global::Log(DATATRIVIAL, EVENT, "PurposeSystem", "Occurrence", TEXT("No Events loaded yet."));
 			return false;
 		}
 
@@ -970,7 +1687,6 @@ namespace PurposeSystem
 		potentialPurposes.AddressLayer = (int)EPurposeLayer::Event;/// As this is an Occurrence we have to initialize which Purpose Layer this will be evaluated for
 		potentialPurposes.purposeOwner = headOfPurposeManagement;
 
-		TArray<FPurpose> events = potentialPurposes.purposeOwner->GetEventAssets();
 		TArray<TScriptInterface<IDataMapInterface>> candidates = potentialPurposes.purposeOwner->GetCandidatesForSubPurposeSelection(potentialPurposes.AddressLayer);
 		TArray<FSubjectMap> subjects;
 		for (auto candidate : candidates)/// At least 1 entry is required as the purpose evaluation works on a for loop
@@ -980,17 +1696,21 @@ namespace PurposeSystem
 
 		TArray<FPotentialPurposeEntry> entries;
 
-		for (int i = 0; i < events.Num(); ++i)
+		TArrayView<const FPurposeTreeNode> events = purposeTree->Events();
+		for (int32 eventIndex = 0; eventIndex < events.Num(); ++eventIndex)
 		{
-			/// As this is the first layer of purpose, we can't provide a previous purpose address, so we simply set the address to the index of the cached EventAssets
-			FPotentialPurposeEntry entry(events[i], FPurposeAddress(i), subjects);
-
-			entries.Add(entry);
+			if (!purposeTree->IsEventResident(eventIndex))
+			{
+				continue;/// Scored once it has loaded, its address is already reserved so nothing selected beforehand is affected
+			}
+			/// As this is the first layer of purpose, there is no previous purpose address, the address is simply the slot reserved for the Event by the director
+			entries.Add(FPotentialPurposeEntry(events[eventIndex], subjects));
 		}
 
 		potentialPurposes.potentialPurposes = entries;
-		potentialPurposes.staticSubjectMapForPotentialPurposes = subjectsOfContext;
-		potentialPurposes.ContextDataForPotentialPurposes = context;
+		potentialPurposes.purposeTree = purposeTree;
+		potentialPurposes.parent = FPotentialPurposes::CreateParent(subjectsOfContext, context, contextValues, headOfPurposeManagement->GetWorldStateBlackboard());
+		potentialPurposes.ResolveBlackboardIndices(headOfPurposeManagement->GetWorldStateBlackboard());
 
 		/// Queue the subjects, context, and potential purposes to background thread
 		/// At this time, we don't bother with UniqueSubjects for Occurrences, as Conditions for Events are revolving strictly around the context of the Occurrence
@@ -1001,9 +1721,50 @@ namespace PurposeSystem
 	{
 		int nextPurposeLayer = contextToParentPurpose.addressOfPurpose.GetAddressLayer() + 1;/// Because we are now evaluating sub purposes, we raise the address layer so the background thread is aware 
 		
-		TArray<FPurpose> potentialPurposesForEvaluation = contextToParentPurpose.purposeOwner->GetSubPurposesFor(contextToParentPurpose.addressOfPurpose);
+		FCompiledPurposeTreePtr purposeTree = contextToParentPurpose.purposeOwner->GetPurposeTree();
+		if (!purposeTree.IsValid())
+		{
+			Global::LogError(PURPOSE, "PurposeSystem", "QueueNextPurposeLayer", TEXT("No purpose tree to find the sub purposes of %s!"), *contextToParentPurpose.GetPurposeChainName());
+			return;
+		}
+
+		/// The owner may first need to gather subjects asynchronously, in which case it queues the sub purposes itself once they arrive
+		if (contextToParentPurpose.purposeOwner->GatherSubjectsForSubPurposeSelection(nextPurposeLayer, contextToParentPurpose, purposeTree->ChildrenOf(contextToParentPurpose.addressOfPurpose)))
+		{
+			return;
+		}
+
+		QueueSubPurposesForCandidates(contextToParentPurpose);
+	}
+
+	/// Establishes a FPotentialPurposes of every sub purpose of contextToParentPurpose for each candidate, then queues them to the background threads
+	/// Called by QueueNextPurposeLayer, or by the owner of contextToParentPurpose once GatherSubjectsForSubPurposeSelection has finished
+	static void QueueSubPurposesForCandidates(const FContextData& contextToParentPurpose)
+	{
+		int nextPurposeLayer = contextToParentPurpose.addressOfPurpose.GetAddressLayer() + 1;
+
+		FCompiledPurposeTreePtr purposeTree = contextToParentPurpose.purposeOwner->GetPurposeTree();
+		if (!purposeTree.IsValid())
+		{
+			Global::LogError(PURPOSE, "PurposeSystem", "QueueSubPurposesForCandidates", TEXT("No purpose tree to find the sub purposes of %s!"), *contextToParentPurpose.GetPurposeChainName());
+			return;
+		}
+		TArrayView<const FPurposeTreeNode> potentialPurposesForEvaluation = purposeTree->ChildrenOf(contextToParentPurpose.addressOfPurpose);
 		TArray<TScriptInterface<IDataMapInterface>> candidates = contextToParentPurpose.purposeOwner->GetCandidatesForSubPurposeSelection(nextPurposeLayer);
 
+		/// The static subject map and context are the same for every candidate, so they're copied once and shared
+			/// We separate the static and potential subject maps to avoid duplicating the static SubjectMap per UniqueSubject entry
+			/// The Context subject is static data that once added to context does not change, plus we can't store it as a TScriptInterface<IDataMapInterface>, so we're forced to keep it separate
+		const FPotentialPurposesParentPtr parent = FPotentialPurposes::CreateParent(
+			contextToParentPurpose.subjectMap
+			, contextToParentPurpose.contextData
+			, contextToParentPurpose.contextValues
+			, contextToParentPurpose.purposeOwner->GetWorldStateBlackboard()
+		);
+
+		FJointPotentialPurposes jointPurposes;
+		const bool bAssignJointly = contextToParentPurpose.purposeOwner->AssignSubPurposesJointly(nextPurposeLayer, contextToParentPurpose, potentialPurposesForEvaluation, jointPurposes);
+
 		/// For every candidate, we establish a FPotentialPurposes
 			/// Which contains not only the sub purpose of the contextOfParentPurpose, but also a subject map relevant specifically to that sub purpose
 		for (TScriptInterface<IDataMapInterface> candidate : candidates)
@@ -1027,28 +1788,34 @@ namespace PurposeSystem
 
 			TArray<FPotentialPurposeEntry> purposeEntries;
 			/// Now we need to establish unique subject entries, based off the candidate, for each individual potential purpose
-			for ( int i = 0; i < potentialPurposesForEvaluation.Num(); ++i)
+			for (const FPurposeTreeNode& subPurpose : potentialPurposesForEvaluation)
 			{
-				FPurpose& purpose = potentialPurposesForEvaluation[i];
-				FPurposeAddress purposeAddress(contextToParentPurpose.addressOfPurpose, i);/// VERY IMPORTANT, this is how the sub purpose address is established, and is a huge aspect of the PurposeSystem
-
 				/// Each UniqueSubject entry is a combination of the candidate + any other relevant subject to this purpose, such as a target
-				TArray<FSubjectMap> UniqueSubjects = contextToParentPurpose.purposeOwner->GetUniqueSubjectsRequiredForSubPurposeSelection(nextPurposeLayer, contextToParentPurpose, candidate, purposeAddress);
-				FPotentialPurposeEntry entry(purpose, purposeAddress, UniqueSubjects);
-				purposeEntries.Add(entry);
+				TArray<FSubjectMap> UniqueSubjects = contextToParentPurpose.purposeOwner->GetUniqueSubjectsRequiredForSubPurposeSelection(nextPurposeLayer, contextToParentPurpose, candidate, subPurpose.address);
+				purposeEntries.Add(FPotentialPurposeEntry(subPurpose, UniqueSubjects));
 			}
 
-			potentialPurposes.potentialPurposes = purposeEntries;
+			potentialPurposes.potentialPurposes = MoveTemp(purposeEntries);
+			potentialPurposes.purposeTree = purposeTree;
+			potentialPurposes.parent = parent;
 
-			potentialPurposes.staticSubjectMapForPotentialPurposes = contextToParentPurpose.subjectMap;/// We separate the static and potential subject maps to avoid duplicating the static SubjectMap per UniqueSubject enry
-			potentialPurposes.ContextDataForPotentialPurposes = contextToParentPurpose.contextData;/// The Context subject, but it's static data that once added to context does not change, plus we can't store it as a TScriptInterface<IDataMapInterface>
-			/// So we're forced to keep it separate
+			potentialPurposes.ResolveBlackboardIndices(contextToParentPurpose.purposeOwner->GetWorldStateBlackboard());/// Background threads read subject data from the blackboard by these indices
 
-			potentialPurposes.SetDescriptionOfParentPurpose(contextToParentPurpose);/// For our own debug sanity, it's nice have a description and setting up a chain or purpose descriptions with their owner
+			if (bAssignJointly)
+			{
+				jointPurposes.candidates.Add(MoveTemp(potentialPurposes));
+				continue;
+			}
 
 			/// Queue the subjects, context, and potential purposes to background thread
 			PurposeSystem::QueuePurposeToBackgroundThread(potentialPurposes, contextToParentPurpose.purposeOwner->GetBackgroundPurposeThreads());
 		}
+
+		if (bAssignJointly && jointPurposes.candidates.Num() > 0)
+		{
+			/// Every candidate is queued as one, so the thread may share the sub purposes out between them
+			PurposeSystem::QueueJointPurposesToBackgroundThread(MoveTemp(jointPurposes), contextToParentPurpose.purposeOwner->GetBackgroundPurposeThreads());
+		}
 	}
 
 	/// The background thread has found a purpose
@@ -1075,25 +1842,25 @@ namespace PurposeSystem
 			return;
 		}
 
-		contextOfSelectedPurpose.AdjustDataIfPossible(contextOfSelectedPurpose.purpose.DataAdjustments(), EPurposeSelectionEvent::OnSelected, PURPOSE, "PurposeSelected", nullptr, "PurposeSystem");
+		contextOfSelectedPurpose.AdjustDataIfPossible(contextOfSelectedPurpose.Purpose().DataAdjustments(), EPurposeSelectionEvent::OnSelected, PURPOSE, "PurposeSelected", nullptr, "PurposeSystem");
 
 		bool bSubParticipantsIncreased = false;
 
-		FContextData& parentContext = contextOfSelectedPurpose.purposeOwner->GetStoredPurpose(contextOfSelectedPurpose.GetContextID(), contextOfSelectedPurpose.addressOfPurpose, contextOfSelectedPurpose.addressOfPurpose.GetAddressLayer() - 1);
-		if (parentContext.ContextIsValid())
+		FContextData* parentContext = contextOfSelectedPurpose.purposeOwner->GetStoredPurpose(contextOfSelectedPurpose.GetContextID(), contextOfSelectedPurpose.addressOfPurpose, contextOfSelectedPurpose.addressOfPurpose.GetAddressLayer() - 1);
+		if (parentContext)
 		{
 			/// Given a parent purpose, we need to ensure that sub purposes are tracked
-			/// They only need to be added once though, as they are already stored within a context
-			parentContext.subPurposeParticipants.FindOrAdd(contextOfSelectedPurpose.addressOfPurpose, 0);
-			parentContext.subPurposeStatus.FindOrAdd(contextOfSelectedPurpose.addressOfPurpose, EPurposeState::Ongoing);
+			parentContext->TrackSubPurpose(contextOfSelectedPurpose.addressOfPurpose);
+
+			bSubParticipantsIncreased = parentContext->IncreaseSubPurposeParticipants(contextOfSelectedPurpose.addressOfPurpose);
 
-			bSubParticipantsIncreased = parentContext.IncreaseSubPurposeParticipants(contextOfSelectedPurpose.addressOfPurpose);
+			contextOfSelectedPurpose.purposeOwner->StoredPurposeChanged(*parentContext);
 		}
 
 		if (!bSubParticipantsIncreased)/// If the participants were not increased it was because the address or parent context was not found 
 		{
 			Global::Log(DATADEBUG, PURPOSE, "PurposeSystem", "PurposeSelected", TEXT("%s for %s.")
-				, parentContext.ContextIsValid() ? TEXT("Parent Context did not increase participants") : TEXT("Parent Context was not found")
+				, parentContext ? TEXT("Parent Context did not increase participants") : TEXT("Parent Context was not found")
 				, *contextOfSelectedPurpose.GetPurposeChainName()
 			);
 		}
@@ -1265,21 +2032,23 @@ public:
 };
 
 /// <summary>
-/// ASyncGraphTask_ReOccurrence is used to notify a Level Director that an Event should have its Candidates reevaluate the Objectives of that Event
+/// ASyncGraphTask_ReOccurrence is used to notify the owner of an active purpose that it was selected again, such as a Level Director having the Candidates of an Event reevaluate its Objectives
+/// The ID of the active context tree is carried along, so the owner may go straight to the tree rather than searching for it
 /// </summary>
 class FAsyncGraphTask_ReOccurrence
 {
 protected:
-	int indexOfEvent = -1;
-	TWeakObjectPtr<class ADirector_Level> levelDirector = nullptr;
-	FPurposeEvaluationThread& callingThread;///Used to detect stopThread
+	/// Weak, as the owner may end play before the task reaches the game thread
+	TWeakInterfacePtr<IPurposeManagementInterface> purposeOwner;
+	FPurposeAddress addressOfPurpose;
+	int64 uniqueIDofActivePurpose = 0;
 	bool shouldAbandon = false;
 
 public:
-	FAsyncGraphTask_ReOccurrence(int inEventIndex, TWeakObjectPtr<class ADirector_Level> inLevelDirector, FPurposeEvaluationThread& inCallingThread)
-		: indexOfEvent(inEventIndex),
-		levelDirector(inLevelDirector),
-		callingThread(inCallingThread)
+	FAsyncGraphTask_ReOccurrence(TScriptInterface<IPurposeManagementInterface> inPurposeOwner, const FPurposeAddress inAddressOfPurpose, const int64 inUniqueIDofActivePurpose)
+		: purposeOwner(inPurposeOwner.GetObject())
+		, addressOfPurpose(inAddressOfPurpose)
+		, uniqueIDofActivePurpose(inUniqueIDofActivePurpose)
 	{
 //		callingThread.reOccurrenceTasks.Add(this);
 	}
@@ -1315,6 +2084,40 @@ protected:
 
 };
 
+/// <summary>
+/// ASyncGraphTask_CompletionEvaluated posts the result of a FCompletionCheck back to the game thread
+/// </summary>
+class FAsyncGraphTask_CompletionEvaluated
+{
+protected:
+	/// Weak, as the requester may end play while the check is evaluated
+	TWeakInterfacePtr<IPurposeManagementInterface> requester;
+	int64 uniqueContextID = 0;
+	FPurposeAddress addressOfPurpose;
+	EPurposeState status = EPurposeState::None;
+
+public:
+	FAsyncGraphTask_CompletionEvaluated(TScriptInterface<IPurposeManagementInterface> inRequester, const int64 inUniqueContextID, const FPurposeAddress inAddressOfPurpose, const EPurposeState inStatus)
+		: requester(inRequester.GetObject())
+		, uniqueContextID(inUniqueContextID)
+		, addressOfPurpose(inAddressOfPurpose)
+		, status(inStatus)
+	{
+	}
+
+	FORCEINLINE TStatId GetStatId() const { RETURN_QUICK_DECLARE_CYCLE_STAT(FAsyncGraphTask_CompletionEvaluated, STATGROUP_TaskGraphTasks); }
+	static FORCEINLINE ENamedThreads::Type GetDesiredThread() { return ENamedThreads::GameThread; }
+	static FORCEINLINE ESubsequentsMode::Type GetSubsequentsMode() { return ESubsequentsMode::FireAndForget; }
+
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		if (IPurposeManagementInterface* validRequester = requester.Get())
+		{
+			validRequester->CompletionEvaluated(uniqueContextID, addressOfPurpose, status);
+		}
+	}
+};
+
 /// <summary>
 /// ASyncGraphTask_PurposeSelected is utilized by the background thread to send a ContextData with a purpose back to the gamethread
 /// </summary>
@@ -1326,8 +2129,8 @@ protected:
 	bool shouldAbandon = false;
 
 public:
-	FAsyncGraphTask_PurposeSelected(FContextData inContext)
-		: contextData(inContext)
+	FAsyncGraphTask_PurposeSelected(FContextData&& inContext)
+		: contextData(MoveTemp(inContext))
 	{
 	}
 
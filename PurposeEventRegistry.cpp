@@ -0,0 +1,136 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+
+#include "Purpose/PurposeEventRegistry.h"
+#include "GlobalLog.h"
+#include "Async/Async.h"
+
+FPurposeAddress FEventRegistry::Reserve(const FSoftObjectPath& eventKey)
+{
+	if (eventKey.IsNull())
+	{
+		Global::LogError(EVENT, "FEventRegistry", "Reserve", TEXT("An Event source without a path can not be reserved a slot!"));
+		return FPurposeAddress();
+	}
+
+	if (const int32* slot = slotsByKey.Find(eventKey))
+	{
+		return AddressOfSlot(*slot);
+	}
+
+	int32 slot = INDEX_NONE;
+	if (freeSlots.Num() > 0)
+	{
+		slot = freeSlots.Pop(false);
+		keys[slot] = eventKey;
+	}
+	else
+	{
+		slot = events.Add(EmptyEvent());
+		keys.Add(eventKey);
+		generations.Add(0);
+		resident.Add(false);
+		released.Add(false);
+	}
+
+	slotsByKey.Add(eventKey, slot);
+	return AddressOfSlot(slot);
+}
+
+FPurposeAddress FEventRegistry::Find(const FSoftObjectPath& eventKey) const
+{
+	const int32* slot = slotsByKey.Find(eventKey);
+	return slot ? AddressOfSlot(*slot) : FPurposeAddress();
+}
+
+void FEventRegistry::SetEvent(const FPurposeAddress& eventAddress, const FEventLayer& eventLayer)
+{
+	if (!IsCurrent(eventAddress))
+	{
+		Global::LogError(EVENT, "FEventRegistry", "SetEvent", TEXT("Address %s is stale, the Event will not be stored!"), *eventAddress.GetAddressAsString());
+		return;
+	}
+
+	const int32 slot = eventAddress.GetAddressForLayer((int)EPurposeLayer::Event);
+	events[slot] = MakeRegisteredEvent(eventLayer);
+	resident[slot] = true;
+}
+
+void FEventRegistry::Release(const FPurposeAddress& eventAddress)
+{
+	if (!IsCurrent(eventAddress))
+	{
+		return;
+	}
+
+	const int32 slot = eventAddress.GetAddressForLayer((int)EPurposeLayer::Event);
+	if (!released[slot])
+	{
+		released[slot] = true;
+		++numReleased;
+	}
+}
+
+int32 FEventRegistry::UnloadReleased(TFunctionRef<bool(const FPurposeAddress&)> isReferenced)
+{
+	TArray<int32> releasedSlots;
+	for (TConstSetBitIterator<> releasedSlot(released); releasedSlot; ++releasedSlot)
+	{
+		releasedSlots.Add(releasedSlot.GetIndex());
+	}
+
+	int32 numUnloaded = 0;
+	for (const int32 slot : releasedSlots)
+	{
+		if (isReferenced(AddressOfSlot(slot)))
+		{
+			continue;
+		}
+
+		Global::Log(DATADEBUG, EVENT, "FEventRegistry", "UnloadReleased", TEXT("Unloading %s from slot %d, generation %d.")
+			, *events[slot]->eventLayer.descriptionOfPurpose
+			, slot
+			, generations[slot]
+		);
+
+		slotsByKey.Remove(keys[slot]);
+		events[slot] = EmptyEvent();/// Trees compiled before now keep the Event alive until they are released
+		keys[slot].Reset();
+		++generations[slot];/// Any address still held to the unloaded Event no longer matches the slot
+		resident[slot] = false;
+		released[slot] = false;
+		freeSlots.Add(slot);
+		++numUnloaded;
+	}
+
+	numReleased -= numUnloaded;
+	return numUnloaded;
+}
+
+bool FEventRegistry::IsCurrent(const FPurposeAddress& address) const
+{
+	const int32 slot = address.GetAddressForLayer((int)EPurposeLayer::Event);
+	return generations.IsValidIndex(slot) && generations[slot] == address.GetGeneration() && !keys[slot].IsNull();
+}
+
+FRegisteredEventPtr FEventRegistry::MakeRegisteredEvent(const FEventLayer& eventLayer)
+{
+	return FRegisteredEventPtr(new FRegisteredEvent(eventLayer), [](FRegisteredEvent* registeredEvent)
+	{
+		if (IsInGameThread())
+		{
+			delete registeredEvent;
+			return;
+		}
+		AsyncTask(ENamedThreads::GameThread, [registeredEvent]() { delete registeredEvent; });
+	});
+}
+
+const FRegisteredEventPtr& FEventRegistry::EmptyEvent()
+{
+	if (!emptyEvent.IsValid())
+	{
+		emptyEvent = MakeRegisteredEvent(FEventLayer());
+	}
+	return emptyEvent;
+}
@@ -0,0 +1,101 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Purpose/Assets/EventAsset.h"
+#include "UObject/GCObject.h"
+
+/// <summary>
+/// A single Event as held by FEventRegistry, shared by every FCompiledPurposeTree compiled while it was resident rather than copied into each
+/// Holds the UObjects of the Event, such as its conditions and behavior abilities, for as long as any tree does, so a tree outliving the unload of its Event never reads a collected object
+/// Only ever destroyed on the game thread, see FEventRegistry::MakeRegisteredEvent
+/// </summary>
+struct FRegisteredEvent : public FGCObject
+{
+public:
+
+	/// The relationship matrix is compiled here, once per Event, as the layer is never modified afterwards
+	explicit FRegisteredEvent(const FEventLayer& inEventLayer)
+		: eventLayer(inEventLayer)
+	{
+		eventLayer.CompileRelationshipMatrix();
+	}
+
+	void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		Collector.AddPropertyReferences(FEventLayer::StaticStruct(), &eventLayer);
+	}
+
+	FString GetReferencerName() const override { return TEXT("FRegisteredEvent"); }
+
+	FEventLayer eventLayer;
+};
+
+/// <summary>
+/// Owns every Event the purpose system may select, each within a slot whose index is the Event layer of its FPurposeAddress
+/// Slots are reserved by the path of the source of the Event, its asset or activity, so a source always resolves to the same slot while registered
+/// The path itself is the key rather than a hash of it, so two sources never share a slot
+/// Once an Event unloads its slot is freed for reuse under the next generation, so addresses still held to the unloaded Event are detected as stale rather than resolving to its replacement
+/// Game thread only
+/// </summary>
+struct FEventRegistry
+{
+public:
+
+	/// @return FPurposeAddress: The Event address of the slot already reserved for eventKey, otherwise of a free or new slot, invalid for a null eventKey
+	FPurposeAddress Reserve(const FSoftObjectPath& eventKey);
+
+	/// @return FPurposeAddress: The Event address reserved for eventKey, invalid if there is none
+	FPurposeAddress Find(const FSoftObjectPath& eventKey) const;
+
+	/// Stores the Event within its reserved slot, after which it is resident and provided to occurrences
+	void SetEvent(const FPurposeAddress& eventAddress, const FEventLayer& eventLayer);
+
+	/// The source of the Event is gone, so it may be unloaded once no tracked context references it
+	void Release(const FPurposeAddress& eventAddress);
+
+	/// Frees the slot of every released Event which isReferenced no longer holds
+	/// @param isReferenced: Whether any tracked context still belongs to the Event at the address
+	/// @return int32: The number of Events unloaded
+	int32 UnloadReleased(TFunctionRef<bool(const FPurposeAddress&)> isReferenced);
+
+	/// @return bool: Whether the Event layer of address is a reserved slot of the same generation
+	bool IsCurrent(const FPurposeAddress& address) const;
+
+	bool HasPendingUnloads() const { return numReleased > 0; }
+
+	bool AllResident() const { return resident.CountSetBits() == resident.Num(); }
+
+	/// Each of the following is indexed by slot
+	/// Free and unloaded slots share a single empty Event
+	const TArray<FRegisteredEventPtr>& Events() const { return events; }
+	const TBitArray<>& Resident() const { return resident; }
+	const TArray<uint16>& Generations() const { return generations; }
+
+private:
+
+	/// Trees are released on whichever thread last held them, yet a FGCObject may only be unregistered on the game thread
+	/// @return FRegisteredEventPtr: Deleted on the game thread once the last tree holding it is released
+	static FRegisteredEventPtr MakeRegisteredEvent(const FEventLayer& eventLayer);
+
+	/// Created by the first Reserve, rather than statically, as a FGCObject may not outlive the engine
+	const FRegisteredEventPtr& EmptyEvent();
+
+	TArray<FRegisteredEventPtr> events;
+	FRegisteredEventPtr emptyEvent;
+	/// A null path marks a free slot, which Reserve never accepts as a key
+	TArray<FSoftObjectPath> keys;
+	TArray<uint16> generations;
+	TBitArray<> resident;
+	TBitArray<> released;
+
+	int32 numReleased = 0;
+
+	/// Reused before the arrays grow
+	TArray<int32> freeSlots;
+
+	TMap<FSoftObjectPath, int32> slotsByKey;
+
+	FPurposeAddress AddressOfSlot(const int32 slot) const { return FPurposeAddress(slot, generations[slot]); }
+};
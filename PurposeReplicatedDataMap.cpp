@@ -0,0 +1,60 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+
+#include "Purpose/PurposeReplicatedDataMap.h"
+
+void FReplicatedDataMap::SyncFrom(const TArray<FDataMapEntry>& dataMap, const uint32 version)
+{
+	if (bHasSynced && version == syncedVersion)
+	{
+		return;
+	}
+	bHasSynced = true;
+	syncedVersion = version;
+
+	TMap<const UClass*, const FDataMapEntry*> entriesByClass;
+	entriesByClass.Reserve(dataMap.Num());
+	for (const FDataMapEntry& entry : dataMap)
+	{
+		entriesByClass.Add(ChunkClassOf(entry), &entry);
+	}
+
+	bool bItemsRemoved = false;
+	for (int32 i = items.Num() - 1; i >= 0; --i)/// Backwards, so the item swapped into a removed one has already been matched
+	{
+		const FDataMapEntry* entry = nullptr;
+		if (entriesByClass.RemoveAndCopyValue(ChunkClassOf(items[i].entry), entry))
+		{
+			if (!(items[i].entry == *entry))
+			{
+				items[i].entry = *entry;
+				MarkItemDirty(items[i]);
+			}
+		}
+		else
+		{
+			/// Items are identified by their replication ID rather than their index, so the item swapped in is not resent
+			items.RemoveAtSwap(i, 1, false);
+			bItemsRemoved = true;
+		}
+	}
+
+	for (const TPair<const UClass*, const FDataMapEntry*>& addedEntry : entriesByClass)
+	{
+		MarkItemDirty(items.Add_GetRef(FReplicatedDataMapItem(*addedEntry.Value)));
+	}
+
+	if (bItemsRemoved)
+	{
+		MarkArrayDirty();
+	}
+}
+
+void FReplicatedDataMap::CopyTo(TArray<FDataMapEntry>& dataMap) const
+{
+	dataMap.Reset(items.Num());
+	for (const FReplicatedDataMapItem& item : items)
+	{
+		dataMap.Add(item.entry);
+	}
+}
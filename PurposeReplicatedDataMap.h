@@ -0,0 +1,72 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "PurposeReplicatedDataMap.generated.h"
+
+USTRUCT()
+/// A single entry of FReplicatedDataMap, marked dirty individually so only it is resent when it changes
+struct FReplicatedDataMapItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+public:
+
+	FReplicatedDataMapItem() {}
+	FReplicatedDataMapItem(const FDataMapEntry& inEntry) : entry(inEntry) {}
+
+	UPROPERTY()
+	/// The chunk is sent by reference, its own properties replicate as a subobject and are quantized by the chunk type's own serialization
+	FDataMapEntry entry;
+};
+
+USTRUCT()
+/// <summary>
+/// The replicated form of an IDataMapInterface data map
+/// Rather than resending the whole array whenever any entry changes, only the entries changed since the last sync are sent
+/// The server calls SyncFrom whenever the data map version changes, clients rebuild their data map through CopyTo on rep notify
+/// </summary>
+struct FReplicatedDataMap : public FFastArraySerializer
+{
+	GENERATED_BODY()
+public:
+
+	/// Server only. Items are matched to entries by chunk class, of which a data map holds at most one
+	/// So only added and changed entries are marked dirty, and a removed entry never resends those after it
+	/// @param version: The data map version being synced, repeated calls for the same version are ignored
+	void SyncFrom(const TArray<FDataMapEntry>& dataMap, const uint32 version);
+
+	/// Client only. Replaces dataMap with the replicated entries, whose order may differ from that of the server
+	void CopyTo(TArray<FDataMapEntry>& dataMap) const;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FReplicatedDataMapItem, FReplicatedDataMap>(items, DeltaParms, *this);
+	}
+
+private:
+
+	/// @return const UClass*: The class an entry is matched by, nullptr for an invalid chunk
+	static const UClass* ChunkClassOf(const FDataMapEntry& entry)
+	{
+		return IsValid(entry.Chunk) ? entry.Chunk->GetClass() : nullptr;
+	}
+
+	UPROPERTY()
+	TArray<FReplicatedDataMapItem> items;
+
+	/// Not replicated, so the server knows whether the data map has changed since it last synced
+	uint32 syncedVersion = 0;
+	bool bHasSynced = false;
+};
+
+template<>
+struct TStructOpsTypeTraits<FReplicatedDataMap> : public TStructOpsTypeTraitsBase2<FReplicatedDataMap>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
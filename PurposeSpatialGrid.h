@@ -0,0 +1,144 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// <summary>
+/// A uniform grid over the horizontal plane of every registered purpose entity, such as each UPurposeAbilityComponent by the location of its avatar
+/// Allows targeting by radius to visit only the cells the radius overlaps, rather than running an EQS query and resolving each actor found back to its component
+/// Entities report their own movement, only changing cells when they cross a cell boundary
+/// Owned by the head of purpose management, see IPurposeManagementInterface::GetSpatialGrid
+/// Game thread only
+/// </summary>
+struct FPurposeSpatialGrid
+{
+public:
+
+	void Add(const UObject* entity, const FVector& location)
+	{
+		if (!entity)
+		{
+			return;
+		}
+
+		if (entries.Contains(entity))
+		{
+			Move(entity, location);
+			return;
+		}
+
+		const FIntPoint cell = CellOf(location);
+		entries.Add(entity, FEntry{ location, cell, const_cast<UObject*>(entity) });
+		cells.FindOrAdd(cell).Add(entity);
+	}
+
+	/// Cheap when the entity remains in its cell, as only its location is updated
+	void Move(const UObject* entity, const FVector& location)
+	{
+		FEntry* entry = entries.Find(entity);
+		if (!entry)
+		{
+			return;
+		}
+
+		entry->location = location;
+		const FIntPoint cell = CellOf(location);
+		if (cell != entry->cell)
+		{
+			RemoveFromCell(entity, entry->cell);
+			cells.FindOrAdd(cell).Add(entity);
+			entry->cell = cell;
+		}
+	}
+
+	void Remove(const UObject* entity)
+	{
+		FEntry entry;
+		if (entries.RemoveAndCopyValue(entity, entry))
+		{
+			RemoveFromCell(entity, entry.cell);
+		}
+	}
+
+	/// @param outEntities: Every entity within radius of center, on the horizontal plane
+	void FindInRadius(const FVector& center, const float radius, TArray<UObject*>& outEntities) const
+	{
+		const FIntPoint minCell = CellOf(center - FVector(radius, radius, 0.f));
+		const FIntPoint maxCell = CellOf(center + FVector(radius, radius, 0.f));
+		const double radiusSquared = (double)radius * radius;
+
+		for (int32 x = minCell.X; x <= maxCell.X; ++x)
+		{
+			for (int32 y = minCell.Y; y <= maxCell.Y; ++y)
+			{
+				const TArray<const UObject*>* cellEntities = cells.Find(FIntPoint(x, y));
+				if (!cellEntities)
+				{
+					continue;
+				}
+
+				for (const UObject* entity : *cellEntities)
+				{
+					const FEntry& entry = entries.FindChecked(entity);
+					if (FVector::DistSquared2D(center, entry.location) <= radiusSquared)
+					{
+						if (UObject* liveEntity = entry.weakEntity.Get())
+						{
+							outEntities.Add(liveEntity);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/// @return bool: False if the entity was never added, outLocation then left untouched
+	bool LocationOf(const UObject* entity, FVector& outLocation) const
+	{
+		if (const FEntry* entry = entries.Find(entity))
+		{
+			outLocation = entry->location;
+			return true;
+		}
+		return false;
+	}
+
+	int32 Num() const { return entries.Num(); }
+
+	/// Roughly the radius most targeting asks for, so a query visits a handful of cells
+	/// Only to be changed while the grid is empty
+	float cellSize = 2000.f;
+
+private:
+
+	struct FEntry
+	{
+		FVector location = FVector::ZeroVector;
+		FIntPoint cell = FIntPoint::ZeroValue;
+
+		/// Entities are removed as they end play, this only guards the window before then
+		TWeakObjectPtr<UObject> weakEntity;
+	};
+
+	FIntPoint CellOf(const FVector& location) const
+	{
+		return FIntPoint(FMath::FloorToInt32(location.X / cellSize), FMath::FloorToInt32(location.Y / cellSize));
+	}
+
+	void RemoveFromCell(const UObject* entity, const FIntPoint& cell)
+	{
+		if (TArray<const UObject*>* cellEntities = cells.Find(cell))
+		{
+			cellEntities->RemoveSingleSwap(entity);
+			if (cellEntities->Num() == 0)
+			{
+				cells.Remove(cell);
+			}
+		}
+	}
+
+	TMap<const UObject*, FEntry> entries;
+
+	TMap<FIntPoint, TArray<const UObject*>> cells;
+};
@@ -0,0 +1,136 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakInterfacePtr.h"
+#include "DataMapInterface.h"
+
+/// A targeting query run by a single querier on behalf of a single context tree
+struct FTargetQueryKey
+{
+	FTargetQueryKey() {}
+	FTargetQueryKey(const class UEnvQuery* inQuery, const UObject* inQuerier, const int64 inContextID)
+		: query(inQuery)
+		, querier(inQuerier)
+		, contextID(inContextID)
+	{}
+
+	const class UEnvQuery* query = nullptr;
+	const UObject* querier = nullptr;
+	int64 contextID = 0;
+
+	FORCEINLINE bool operator ==(const FTargetQueryKey& other) const
+	{
+		return query == other.query && querier == other.querier && contextID == other.contextID;
+	}
+};
+FORCEINLINE uint32 GetTypeHash(const FTargetQueryKey& key)
+{
+	return HashCombine(HashCombine(GetTypeHash(key.query), GetTypeHash(key.querier)), GetTypeHash(key.contextID));
+}
+
+struct FCachedTargets
+{
+	/// Weak, as a target may be destroyed while cached
+	TArray<TWeakInterfacePtr<IDataMapInterface>> targets;
+
+	uint64 frameCached = 0;
+	double timeCached = 0.0;
+};
+
+/// <summary>
+/// Holds the targets found by each targeting query, so every candidate and Objective asking the same query within a context tree shares one result
+/// An entry is always reused within the frame it was cached, and afterwards for up to lifetime seconds
+/// Entries are dropped once any target has been destroyed, or when their context tree is invalidated
+/// Owned by each manager, game thread only
+/// </summary>
+struct FTargetQueryCache
+{
+public:
+
+	/// @param now: The world time, as the cache has no world of its own
+	/// @return bool: False if the query has no live entry, outTargets then left untouched
+	bool Find(const FTargetQueryKey& key, const double now, TArray<TScriptInterface<IDataMapInterface>>& outTargets)
+	{
+		const FCachedTargets* cached = entries.Find(key);
+		if (!cached)
+		{
+			return false;
+		}
+
+		const bool bFresh = cached->frameCached == GFrameCounter || now - cached->timeCached <= lifetime;
+		bool bTargetsLive = bFresh;
+		for (int32 i = 0; bTargetsLive && i < cached->targets.Num(); ++i)
+		{
+			bTargetsLive = cached->targets[i].IsValid();
+		}
+
+		if (!bTargetsLive)
+		{
+			entries.Remove(key);
+			return false;
+		}
+
+		outTargets.Reserve(outTargets.Num() + cached->targets.Num());
+		for (const TWeakInterfacePtr<IDataMapInterface>& target : cached->targets)
+		{
+			outTargets.Add(target.ToScriptInterface());
+		}
+		++hits;
+		return true;
+	}
+
+	void Add(const FTargetQueryKey& key, const double now, const TArray<TScriptInterface<IDataMapInterface>>& targets)
+	{
+		FCachedTargets& cached = entries.FindOrAdd(key);
+		cached.targets.Reset(targets.Num());
+		for (const TScriptInterface<IDataMapInterface>& target : targets)
+		{
+			cached.targets.Add(TWeakInterfacePtr<IDataMapInterface>(target.GetObject()));
+		}
+		cached.frameCached = GFrameCounter;
+		cached.timeCached = now;
+		++misses;
+	}
+
+	/// Drops every entry of the context tree, such as when its Goals end or are reevaluated
+	void InvalidateContext(const int64 contextID)
+	{
+		for (auto it = entries.CreateIterator(); it; ++it)
+		{
+			if (it->Key.contextID == contextID)
+			{
+				it.RemoveCurrent();
+			}
+		}
+	}
+
+	/// Called once per tick, drops every entry which can no longer be reused
+	void RemoveExpired(const double now)
+	{
+		for (auto it = entries.CreateIterator(); it; ++it)
+		{
+			if (it->Value.frameCached != GFrameCounter && now - it->Value.timeCached > lifetime)
+			{
+				it.RemoveCurrent();
+			}
+		}
+	}
+
+	void Reset() { entries.Reset(); }
+
+	int32 Num() const { return entries.Num(); }
+	int32 Hits() const { return hits; }
+	int32 Misses() const { return misses; }
+
+	/// Seconds an entry is reused beyond the frame it was cached in, 0 limiting reuse to that frame
+	float lifetime = 0.25f;
+
+private:
+
+	TMap<FTargetQueryKey, FCachedTargets> entries;
+
+	int32 hits = 0;
+	int32 misses = 0;
+};
@@ -0,0 +1,211 @@
+// Copyright Jordan Cain. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Purpose/PurposeEvaluationThread.h"
+#include "Purpose/DataChunks/TrackedPurposes.h"
+
+/// Identifies a single tracked context, the ID of its context tree and its own address
+struct FTrackedPurposeKey
+{
+	FTrackedPurposeKey(const int64 inContextID, const FPurposeAddress& inAddress)
+		: contextID(inContextID)
+		, address(inAddress)
+	{}
+
+	int64 contextID = 0;
+	FPurposeAddress address;
+
+	FORCEINLINE bool operator ==(const FTrackedPurposeKey& other) const
+	{
+		return contextID == other.contextID && address == other.address;
+	}
+};
+/// Matches GetTypeHash(FContextData) for the context the key identifies
+FORCEINLINE uint32 GetTypeHash(const FTrackedPurposeKey& key)
+{
+	return HashCombine(GetTypeHash(key.contextID), GetTypeHash(key.address));
+}
+
+/// <summary>
+/// The contexts a purpose owner tracks, such as the director's Events or a manager's Goals
+/// Indexed by context ID and address, so finding, adding and removing a context never searches the others
+/// Each context is allocated individually and never moves, so the FContextData* handed out by GetStoredPurpose remains valid until that context is removed
+/// The owner's UTrackedPurposes chunk is the data map view of the tracked contexts for replication, the blackboard and conditions, see BindView
+/// The view holds each context at the same index as the store, so adding, removing and updating a context touches only its own entry of the view
+/// Game thread only
+/// </summary>
+struct FTrackedPurposeStore
+{
+public:
+
+	/// @return FContextData*: The stored copy of context, nullptr if a context of the same ID and address is already tracked
+	FContextData* Add(const FContextData& context)
+	{
+		const FTrackedPurposeKey key(context.GetContextID(), context.addressOfPurpose);
+		if (indices.Contains(key))
+		{
+			return nullptr;
+		}
+
+		const int32 index = contexts.Add(MakeUnique<FContextData>(context));
+		indices.Add(key, index);
+		contextTrees.Add(key.contextID, key.address);
+
+		if (UTrackedPurposes* trackedView = view.Get())
+		{
+			trackedView->ValueNonConst().Add(context);
+			ViewChanged();
+		}
+		return contexts[index].Get();
+	}
+
+	/// @param address: The address of the tracked context itself, not one of its sub purposes
+	FContextData* Find(const int64 contextID, const FPurposeAddress& address) const
+	{
+		const int32* index = indices.Find(FTrackedPurposeKey(contextID, address));
+		return index ? contexts[*index].Get() : nullptr;
+	}
+
+	/// @param fullAddress: The address of the tracked context or any of its sub purposes
+	/// @param layer: The EPurposeLayer of the tracked context
+	FContextData* FindForLayer(const int64 contextID, const FPurposeAddress& fullAddress, const int layer) const
+	{
+		return Find(contextID, fullAddress.Truncate(layer + 1));
+	}
+
+	bool Contains(const FContextData& context) const
+	{
+		return indices.Contains(FTrackedPurposeKey(context.GetContextID(), context.addressOfPurpose));
+	}
+
+	bool Remove(const int64 contextID, const FPurposeAddress& address)
+	{
+		int32 index = INDEX_NONE;
+		if (!indices.RemoveAndCopyValue(FTrackedPurposeKey(contextID, address), index))
+		{
+			return false;
+		}
+		contextTrees.RemoveSingle(contextID, address);
+
+		/// The last context takes the place of the removed one, only its index changes as the context itself never moves
+		/// The view swaps the same way, so it keeps the index of the store
+		contexts.RemoveAtSwap(index, 1, false);
+		if (UTrackedPurposes* trackedView = view.Get())
+		{
+			trackedView->ValueNonConst().RemoveAtSwap(index, 1, false);
+			ViewChanged();
+		}
+		if (contexts.IsValidIndex(index))
+		{
+			indices[FTrackedPurposeKey(contexts[index]->GetContextID(), contexts[index]->addressOfPurpose)] = index;
+		}
+		return true;
+	}
+
+	/// @return TArray<FContextData*>: Every tracked context of the context tree
+	TArray<FContextData*> ContextsOf(const int64 contextID) const
+	{
+		TArray<FContextData*> contextsOfTree;
+		for (auto address = contextTrees.CreateConstKeyIterator(contextID); address; ++address)
+		{
+			contextsOfTree.Add(Find(contextID, address.Value()));
+		}
+		return contextsOfTree;
+	}
+
+	/// @return int32: The number of contexts removed from the context tree
+	int32 RemoveContextTree(const int64 contextID)
+	{
+		TArray<FPurposeAddress> addresses;
+		contextTrees.MultiFind(contextID, addresses);
+		for (const FPurposeAddress& address : addresses)
+		{
+			Remove(contextID, address);
+		}
+		return addresses.Num();
+	}
+
+	/// Searches every context, so is only meant for infrequent checks such as whether an Event may be unloaded
+	bool AnyBelongToEvent(const FPurposeAddress& eventAddress) const
+	{
+		return contexts.ContainsByPredicate([&eventAddress](const TUniquePtr<FContextData>& context) { return context->addressOfPurpose.Truncate(1) == eventAddress; });
+	}
+
+	/// @return TArray<int64>: The ID of every context tree with at least one tracked context
+	TArray<int64> ContextTreeIDs() const
+	{
+		TArray<int64> contextIDs;
+		contextTrees.GetKeys(contextIDs);
+		return contextIDs;
+	}
+
+	int32 Num() const { return contexts.Num(); }
+
+	/// Must follow any change made in place to a context handed out by Add, Find or FindForLayer, such as TrackSubPurpose, so its entry in the view matches
+	/// @return bool: False if the context is not tracked by this store
+	bool ContextChanged(const FContextData& context)
+	{
+		const int32* index = indices.Find(FTrackedPurposeKey(context.GetContextID(), context.addressOfPurpose));
+		if (!index)
+		{
+			return false;
+		}
+
+		UTrackedPurposes* trackedView = view.Get();
+		if (trackedView && trackedView->Value().IsValidIndex(*index))
+		{
+			trackedView->ValueNonConst()[*index] = *contexts[*index];
+			ViewChanged();
+		}
+		return true;
+	}
+
+	/// Every Add, Remove and ContextChanged from now on is mirrored into inView, which is rebuilt from whatever is already tracked
+	/// @param inView: Held within the data map of its outer, whose data map version is raised whenever the view changes
+	void BindView(UTrackedPurposes* inView)
+	{
+		view = inView;
+		if (!inView)
+		{
+			return;
+		}
+
+		TArray<FContextData>& viewContexts = inView->ValueNonConst();
+		viewContexts.Reset(contexts.Num());
+		for (const TUniquePtr<FContextData>& context : contexts)
+		{
+			viewContexts.Add(*context);
+		}
+		ViewChanged();
+	}
+
+	/// A sentinel for lookups which hand out a reference, const so no caller can change what the next receives
+	static const FContextData& InvalidContext()
+	{
+		static const FContextData invalidContext;
+		return invalidContext;
+	}
+
+private:
+
+	/// The view is modified in place, so its holder's data map never sees the change
+	void ViewChanged() const
+	{
+		if (IPurposeManagementInterface* viewOwner = view.IsValid() ? Cast<IPurposeManagementInterface>(view->GetOuter()) : nullptr)
+		{
+			viewOwner->IncrementDataMapVersion();
+		}
+	}
+
+	TWeakObjectPtr<UTrackedPurposes> view;
+
+	TArray<TUniquePtr<FContextData>> contexts;
+
+	/// The index within contexts of each key
+	TMap<FTrackedPurposeKey, int32> indices;
+
+	/// The addresses tracked for each context tree
+	TMultiMap<int64, FPurposeAddress> contextTrees;
+};